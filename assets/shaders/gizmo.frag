@@ -1,9 +1,8 @@
 #version 330 core
+in vec4 vColor;
 out vec4 FragColor;
 
-uniform vec4 u_Color;
-
 void main()
 {
-    FragColor = u_Color;
-}
\ No newline at end of file
+    FragColor = vColor;
+}
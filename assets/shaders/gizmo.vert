@@ -1,12 +1,18 @@
 #version 330 core
 layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec4 aColor;
 
-uniform mat4 u_Projection;
-uniform mat4 u_View;
-uniform mat4 u_Model;
-uniform vec4 u_Color;
+layout (std140) uniform Camera {
+    mat4 u_Projection;
+    mat4 u_View;
+    vec4 u_Viewport;   // width, height, zoom, unused
+};
+
+out vec4 vColor;
 
 void main()
 {
-    gl_Position = u_Projection * u_View * u_Model * vec4(aPos, 0.0, 1.0);
-}
\ No newline at end of file
+    // Vertex gizmo sudah dalam world space, warna per vertex dari DebugDraw
+    vColor = aColor;
+    gl_Position = u_Projection * u_View * vec4(aPos, 0.0, 1.0);
+}
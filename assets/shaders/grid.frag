@@ -1,7 +1,11 @@
 #version 330 core
 out vec4 FragColor;
     
-uniform vec2 uViewport;    // Viewport size
+layout (std140) uniform Camera {
+    mat4 u_Projection;
+    mat4 u_View;
+    vec4 u_Viewport;   // width, height, zoom, unused
+};
 uniform vec2 uPan;         // Pan offset
 uniform float uZoom;       // Zoom level
 uniform vec3 uGridColor;   // Grid line color
@@ -13,7 +17,7 @@ void main() {
     float gridSize = uGridSize * uZoom;
         
     // Hitung koordinat yang sudah dipan dan di-zoom
-    vec2 coord = (gl_FragCoord.xy - uViewport * 0.5) / uZoom + uPan;
+    vec2 coord = (gl_FragCoord.xy - u_Viewport.xy * 0.5) / uZoom + uPan;
         
     // Hitung garis horizontal & vertikal
     float line = step(0.98, abs(fract(coord.x / uGridSize) - 0.5) * 2.0) +
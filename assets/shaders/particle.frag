@@ -0,0 +1,17 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+in vec4 ParticleColor;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+    // Warna texture dikalikan warna partikel (fade dari startColor ke endColor)
+    vec4 color = texture(u_Texture, TexCoord) * ParticleColor;
+    if(color.a < 0.01)
+        discard;
+
+    FragColor = color;
+}
@@ -0,0 +1,22 @@
+#version 330 core
+layout (location = 0) in vec2 aCorner;     // Unit quad 0..1
+layout (location = 1) in vec3 aParticle;   // Per-instance: x, y (pusat), size
+layout (location = 2) in vec4 aColor;      // Per-instance: RGBA8 ternormalisasi
+
+layout (std140) uniform Camera {
+    mat4 u_Projection;
+    mat4 u_View;
+    vec4 u_Viewport;   // width, height, zoom, unused
+};
+
+out vec2 TexCoord;
+out vec4 ParticleColor;
+
+void main()
+{
+    // Partikel selalu menghadap kamera, tanpa rotasi
+    vec2 world = aParticle.xy + (aCorner - 0.5) * aParticle.z;
+    gl_Position = u_Projection * u_View * vec4(world, 0.0, 1.0);
+    TexCoord = aCorner;
+    ParticleColor = aColor;
+}
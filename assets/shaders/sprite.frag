@@ -1,19 +1,25 @@
 #version 330 core
-out vec4 FragColor;
+layout (location = 0) out vec4 FragColor;
+// Attachment ID picking, hanya aktif kalau framebuffer memakainya di draw buffer 1
+layout (location = 1) out uint ObjectID;
 
 in vec2 TexCoord;
+flat in uint PickID;
 
 uniform sampler2D u_Texture;
+// 0.1 untuk sprite translucent, 0.5 untuk pass cutout
+uniform float u_AlphaCutoff;
 
 void main()
 {
     // Sample the texture at the current texture coordinates
     vec4 texColor = texture(u_Texture, TexCoord);
     
-    // Discard fragments with very low alpha
-    if(texColor.a < 0.1)
+    // Discard fragments below the cutoff
+    if(texColor.a < u_AlphaCutoff)
         discard;
         
     // Output the final color
     FragColor = texColor;
+    ObjectID = PickID;
 }
\ No newline at end of file
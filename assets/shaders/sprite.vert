@@ -3,15 +3,22 @@ layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
 
 uniform mat4 u_Model;
-uniform mat4 u_Projection;
+
+layout (std140) uniform Camera {
+    mat4 u_Projection;
+    mat4 u_View;
+    vec4 u_Viewport;   // width, height, zoom, unused
+};
 
 out vec2 TexCoord;
+flat out uint PickID;   // DrawSprite tidak ikut picking
 
 void main()
 {
     // Transform vertex position
-    gl_Position = u_Projection * u_Model * vec4(aPos, 0.0, 1.0);
+    gl_Position = u_Projection * u_View * u_Model * vec4(aPos, 0.0, 1.0);
     
     // Pass texture coordinates to fragment shader
     TexCoord = aTexCoord;
+    PickID = 0u;
 }
\ No newline at end of file
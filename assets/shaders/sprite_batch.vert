@@ -0,0 +1,24 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;      // World position (sudah ditransform di CPU) + depth NDC
+layout (location = 1) in vec2 aTexCoord;
+
+layout (std140) uniform Camera {
+    mat4 u_Projection;
+    mat4 u_View;
+    vec4 u_Viewport;   // width, height, zoom, unused
+};
+
+// Posisi sprite pertama draw call ini di antrian render, 4 vertex per sprite
+uniform int u_PickBase;
+
+out vec2 TexCoord;
+flat out uint PickID;   // Posisi di antrian + 1, 0 = kosong
+
+void main()
+{
+    gl_Position = u_Projection * u_View * vec4(aPos.xy, 0.0, 1.0);
+    // Proyeksi ortho (w = 1), depth diisi langsung dari urutan gambar
+    gl_Position.z = aPos.z;
+    TexCoord = aTexCoord;
+    PickID = uint(u_PickBase + gl_VertexID / 4) + 1u;
+}
\ No newline at end of file
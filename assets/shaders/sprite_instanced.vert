@@ -0,0 +1,38 @@
+#version 330 core
+layout (location = 0) in vec2 aCorner;     // Unit quad 0..1
+layout (location = 1) in vec4 aRect;       // Per-instance: x, y, width, height
+layout (location = 2) in vec4 aTransform;  // Per-instance: rotation (derajat), scaleX, scaleY, depth NDC
+layout (location = 3) in vec4 aUVRect;     // Per-instance: u0, v0, u1, v1
+
+layout (std140) uniform Camera {
+    mat4 u_Projection;
+    mat4 u_View;
+    vec4 u_Viewport;   // width, height, zoom, unused
+};
+
+// Posisi instance pertama draw call ini di antrian render
+uniform int u_PickBase;
+
+out vec2 TexCoord;
+flat out uint PickID;   // Posisi di antrian + 1, 0 = kosong
+
+void main()
+{
+    // Bangun model matrix di GPU: scale, rotate di sekitar titik tengah, lalu translate
+    vec2 size = aRect.zw * aTransform.yz;
+    float angle = radians(aTransform.x);
+    float c = cos(angle);
+    float s = sin(angle);
+    mat4 model = mat4(
+        vec4( c * size.x, s * size.x, 0.0, 0.0),
+        vec4(-s * size.y, c * size.y, 0.0, 0.0),
+        vec4( 0.0,        0.0,        1.0, 0.0),
+        vec4(aRect.xy + size * 0.5,   0.0, 1.0)
+    );
+
+    gl_Position = u_Projection * u_View * model * vec4(aCorner - 0.5, 0.0, 1.0);
+    // Proyeksi ortho (w = 1), depth diisi langsung dari urutan gambar
+    gl_Position.z = aTransform.w;
+    TexCoord = mix(aUVRect.xy, aUVRect.zw, aCorner);
+    PickID = uint(u_PickBase + gl_InstanceID) + 1u;
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 330 core
+layout (location = 0) out vec4 FragColor;
+// Attachment ID picking, hanya aktif kalau framebuffer memakainya di draw buffer 1
+layout (location = 1) out uint ObjectID;
+
+in vec2 TexCoord;
+flat in uint PickID;
+
+uniform sampler2D u_Texture;
+
+// Pass opaque: tanpa discard supaya driver tetap bisa memakai early-Z
+void main()
+{
+    FragColor = vec4(texture(u_Texture, TexCoord).rgb, 1.0);
+    ObjectID = PickID;
+}
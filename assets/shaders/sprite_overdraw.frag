@@ -0,0 +1,17 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+
+uniform sampler2D u_Texture;
+uniform float u_AlphaCutoff;
+
+// Heatmap overdraw: setiap fragment yang lolos depth test menambah warna (blend GL_ONE, GL_ONE).
+// 1 lapis merah gelap, 8 lapis merah penuh, 32 lapis kuning, 128 lapis putih.
+void main()
+{
+    if(texture(u_Texture, TexCoord).a < u_AlphaCutoff)
+        discard;
+
+    FragColor = vec4(1.0 / 8.0, 1.0 / 32.0, 1.0 / 128.0, 1.0);
+}
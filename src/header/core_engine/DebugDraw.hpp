@@ -0,0 +1,67 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "ShaderProgram.hpp"
+#include "StreamBuffer.hpp"
+
+// Vertex debug dalam world space, warna RGBA8 dinormalisasi di shader
+struct DebugVertex {
+    float x, y;
+    uint32_t color;
+};
+
+struct DebugDrawStats {
+    uint32_t lineVertices = 0;
+    uint32_t pointVertices = 0;
+    uint32_t drawCalls = 0;
+};
+
+// Immediate-mode debug draw (line, rect, point, circle) untuk gizmo, selection dan bounds.
+// Shape dikumpulkan di CPU lalu Flush menulis ke StreamBuffer bersama:
+// satu draw call untuk semua line dan satu untuk semua point per pass.
+class DebugDraw {
+public:
+    // Batas vertex per jenis per flush, sisanya dibuang
+    static constexpr uint32_t MaxVertices = 1 << 18;
+
+    DebugDraw() = default;
+    ~DebugDraw();
+
+    void Init(GLStateCache& stateCache, StreamBuffer& streamBuffer);
+    void Shutdown();
+
+    void Line(const glm::vec2& a, const glm::vec2& b, const glm::vec4& color);
+    void Rect(const glm::vec2& min, const glm::vec2& max, const glm::vec4& color);
+    // Rect yang diputar (derajat) di sekitar center, mis. bounds sprite
+    void RotatedRect(const glm::vec2& center, const glm::vec2& halfSize, float rotation, const glm::vec4& color);
+    void Circle(const glm::vec2& center, float radius, const glm::vec4& color, int segments = 32);
+    void Point(const glm::vec2& position, const glm::vec4& color);
+
+    // Upload dan gambar semua shape yang terkumpul dengan program gizmo (UBO kamera sudah di-update)
+    void Flush(ShaderProgram& program);
+    void Clear();
+    bool IsEmpty() const { return lines.empty() && points.empty(); }
+
+    void SetLineWidth(float width) { lineWidth = width; }
+    void SetPointSize(float size) { pointSize = size; }
+
+    void ResetStats() { stats = DebugDrawStats(); }
+    const DebugDrawStats& GetStats() const { return stats; }
+
+private:
+    static uint32_t PackColor(const glm::vec4& color);
+    // Salin vertex ke StreamBuffer, return vertex pertama untuk glDrawArrays (-1 kalau penuh)
+    GLint Upload(const std::vector<DebugVertex>& vertices, uint32_t count);
+
+    GLuint vao = 0;
+    float lineWidth = 2.0f;
+    float pointSize = 8.0f;
+    GLStateCache* state = nullptr;
+    StreamBuffer* stream = nullptr;
+
+    std::vector<DebugVertex> lines;
+    std::vector<DebugVertex> points;
+    DebugDrawStats stats;
+};
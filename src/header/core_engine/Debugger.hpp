@@ -1,7 +1,9 @@
 #pragma once
 #include <iostream>
 #include <string>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 namespace Debug {
     enum class LogLevel {
@@ -14,6 +16,7 @@ namespace Debug {
     class Logger {
     public:
         static void Log(const std::string& message, LogLevel level = LogLevel::INFO) {
+#ifdef _WIN32
             HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
             
             // Set color based on log level
@@ -41,6 +44,26 @@ namespace Debug {
             
             // Reset color
             SetConsoleTextAttribute(hConsole, 15);
+#else
+            // Linux/headless: pakai ANSI escape
+            switch(level) {
+                default:
+                case LogLevel::INFO:
+                    std::cout << "\033[34m[INFO] ";
+                    break;
+                case LogLevel::WARNING:
+                    std::cout << "\033[33m[WARNING] ";
+                    break;
+                case LogLevel::CRASH:
+                    std::cout << "\033[31m[ERROR] ";
+                    break;
+                case LogLevel::SUCCESS:
+                    std::cout << "\033[32m[SUCCESS] ";
+                    break;
+            }
+
+            std::cout << message << "\033[0m" << std::endl;
+#endif
         }
     };
 }
\ No newline at end of file
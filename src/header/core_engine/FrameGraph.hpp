@@ -0,0 +1,82 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include "RenderTargetPool.hpp"
+
+using FrameGraphResource = uint32_t;
+using FrameGraphPass = uint32_t;
+
+class FrameGraph;
+// Callback pass, target di-resolve lewat graph saat pass dijalankan
+using FrameGraphExecute = std::function<void(const FrameGraph&)>;
+
+struct FrameGraphStats {
+    uint32_t passes = 0;             // Dideklarasikan
+    uint32_t culledPasses = 0;       // Hasilnya tidak dibaca siapa pun
+    uint32_t transientTargets = 0;   // Resource transient yang dipakai pass aktif
+    uint32_t physicalTargets = 0;    // Target pool berbeda yang melayani semuanya
+    uint64_t transientBytes = 0;     // Kalau setiap transient punya target sendiri
+    uint64_t physicalBytes = 0;      // Setelah aliasing
+};
+
+// Frame graph kecil untuk pass yang memakai render target. Pass mendeklarasikan target yang dibaca dan
+// ditulis, lalu Execute membuang pass yang hasilnya tidak dipakai, mengurutkan sisanya berdasarkan
+// dependency dan menjalankannya. Target transient diambil dari RenderTargetPool tepat sebelum pass
+// pertama yang memakainya dan dikembalikan setelah pass terakhir, jadi transient yang umurnya tidak
+// tumpang tindih berbagi memori yang sama. Target import (viewport) milik pemanggil dan dianggap output.
+class FrameGraph {
+public:
+    // Mulai graph baru, kapasitas vector dipakai ulang antar frame
+    void Reset();
+
+    FrameGraphResource ImportTarget(const char* name, RenderTarget* target, int width, int height);
+    FrameGraphResource CreateTarget(const char* name, int width, int height);
+
+    FrameGraphPass AddPass(const char* name, FrameGraphExecute execute);
+    void Read(FrameGraphPass pass, FrameGraphResource resource);
+    void Write(FrameGraphPass pass, FrameGraphResource resource);
+    // Pass dengan efek di luar target (readback, upload) tidak pernah di-cull
+    void SetSideEffect(FrameGraphPass pass);
+
+    // Thread GL. False kalau dependency melingkar atau target transient gagal dibuat.
+    bool Execute();
+
+    // Valid di dalam callback pass (transient) atau kapan saja (import)
+    RenderTarget* GetTarget(FrameGraphResource resource) const { return resources[resource].target; }
+    // Ukuran logis, target pool bisa lebih besar (bucket)
+    int GetWidth(FrameGraphResource resource) const { return resources[resource].width; }
+    int GetHeight(FrameGraphResource resource) const { return resources[resource].height; }
+    const FrameGraphStats& GetStats() const { return stats; }
+
+private:
+    struct Resource {
+        const char* name = "";
+        int width = 0, height = 0;
+        RenderTarget* target = nullptr;
+        bool imported = false;
+        uint32_t readers = 0;              // Pass aktif yang membaca, untuk culling
+        std::vector<FrameGraphPass> writers;
+        int firstUse = -1, lastUse = -1;   // Posisi di order
+    };
+    struct Pass {
+        const char* name = "";
+        FrameGraphExecute execute;
+        std::vector<FrameGraphResource> reads;
+        std::vector<FrameGraphResource> writes;
+        bool sideEffect = false;
+        bool culled = false;
+        uint32_t outputs = 0;   // Resource tulisan yang masih dibaca
+    };
+
+    void Cull();
+    bool Sort();
+    void ComputeLifetimes();
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<FrameGraphPass> order;
+    std::vector<uint32_t> dependencies;
+    FrameGraphStats stats;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <cstdint>
+
+struct GLStateStats {
+    uint32_t issued = 0;   // Panggilan GL yang benar-benar dikirim ke driver
+    uint32_t dropped = 0;  // Panggilan no-op yang dibuang karena state sudah sama
+    uint32_t textureBinds = 0; // glBindTexture yang dikirim (bagian dari issued)
+};
+
+// Shadow state GL untuk SceneRenderer2D. Semua bind/enable lewat sini supaya
+// panggilan yang tidak mengubah apa-apa tidak sampai ke driver.
+// Kode lain (mis. backend ImGui) mengubah state di luar cache, jadi panggil
+// BeginFrame() atau Invalidate() sebelum render.
+class GLStateCache {
+public:
+    static constexpr int MaxTextureUnits = 16;
+
+    GLStateCache() { Invalidate(); }
+
+    // Reset counter per frame dan lupakan state yang disimpan
+    void BeginFrame();
+    void Invalidate();
+
+    void BindFramebuffer(GLuint fbo);
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    void BindTexture(GLuint unit, GLuint texture);
+    void SetBlend(bool enabled);
+    void SetBlendFunc(GLenum src, GLenum dst);
+    void SetDepthTest(bool enabled);
+    // glClear(GL_DEPTH_BUFFER_BIT) hanya berlaku kalau depth mask aktif
+    void SetDepthMask(bool enabled);
+    void SetViewport(GLint x, GLint y, GLsizei w, GLsizei h);
+    void SetScissorTest(bool enabled);
+    void SetScissor(GLint x, GLint y, GLsizei w, GLsizei h);
+    void SetClearColor(float r, float g, float b, float a);
+
+    // Dipanggil sebelum glDelete* supaya cache tidak menyimpan nama yang sudah dihapus
+    void ForgetVertexArray(GLuint vao);
+    void ForgetTexture(GLuint texture);
+    void ForgetFramebuffer(GLuint fbo);
+
+    const GLStateStats& GetStats() const { return stats; }
+
+private:
+    bool Changed(bool same);
+
+    // Nilai Unknown berarti state belum diketahui dan panggilan berikutnya pasti dikirim
+    static constexpr GLuint Unknown = 0xFFFFFFFFu;
+
+    GLuint framebuffer;
+    GLuint program;
+    GLuint vertexArray;
+    GLuint activeUnit;
+    GLuint textures[MaxTextureUnits];
+    int blendEnabled;
+    GLenum blendSrc, blendDst;
+    int depthTestEnabled;
+    int depthMaskEnabled;
+    GLint viewport[4];
+    int scissorEnabled;
+    GLint scissor[4];
+    float clearColor[4];
+
+    GLStateStats stats;
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <string>
+
+// Context OpenGL tanpa window (EGL surfaceless), untuk benchmark dan regression test
+// di mesin tanpa display, mis. build farm dengan Mesa llvmpipe.
+// Semua rendering harus ke framebuffer sendiri (RenderTargetPool), tidak ada default framebuffer.
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // Buat context core profile dan load fungsi GL lewat GLAD
+    bool Create(int major = 4, int minor = 5);
+    void Destroy();
+
+    bool IsValid() const { return context != nullptr; }
+    // GL_RENDERER, mis. "llvmpipe (LLVM 15.0.7, 256 bits)"
+    std::string GetRendererName() const;
+
+private:
+    void* display = nullptr;
+    void* context = nullptr;
+};
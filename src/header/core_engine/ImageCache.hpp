@@ -0,0 +1,131 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "SpriteAlpha.hpp"
+#include "TextureCooker.hpp"
+
+// Bentuk texture yang dibuat dari satu file gambar
+enum class ImageVariant : uint8_t {
+    FULL,       // Ukuran asli dengan mip chain (sprite, tileset, background)
+    THUMBNAIL   // Sisi terpanjang <= ThumbnailSize, dari mip file yang sama (icon editor)
+};
+
+struct ImageView {
+    GLuint texture = 0;     // 0 = belum di-load atau gagal
+    int width = 0, height = 0;
+    SpriteAlphaMode alphaMode = SpriteAlphaMode::TRANSLUCENT;
+    uint64_t bytes = 0;     // Memori GPU variant ini termasuk mip
+};
+
+// Salinan kecil gambar di CPU (RGBA8, baris bawah dulu), untuk analisis warna tanpa readback GPU
+struct ImagePreview {
+    int width = 0, height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+// Hasil decode satu file di CPU, selalu dalam bentuk .ilmeetex (dari cache atau baru di-cook)
+struct DecodedImage {
+    std::string path;
+    std::unique_ptr<MappedFile> mapped;
+    std::vector<unsigned char> cookedBlob;
+    CookedTexture cooked;       // Menunjuk mapped atau cookedBlob
+    bool fromCache = false;
+    uint64_t generation = 0;    // Diisi pemanggil (streaming TextureManager)
+
+    bool IsValid() const { return cooked.header != nullptr; }
+};
+
+struct ImageCacheStats {
+    uint32_t entries = 0;
+    uint32_t textures = 0;      // Texture GL hidup (thumbnail yang memakai texture FULL tidak dihitung)
+    uint64_t bytes = 0;
+    uint32_t decodes = 0;       // Decode lewat Get/Acquire (thread GL)
+    uint32_t hits = 0;          // Get/Acquire yang dilayani texture yang sudah ada
+};
+
+// Satu cache gambar untuk seluruh proses: sprite scene, icon dan background editor memakai entry yang sama,
+// jadi satu file hanya di-decode dan di-upload sekali per variant. Semua texture baris bawah dulu (origin GL),
+// ImGui menggambarnya dengan UV (0,1)-(1,0).
+class ImageCache {
+public:
+    static constexpr int ThumbnailSize = 128;
+    static constexpr int PreviewSize = 64;
+
+    static ImageCache& Shared();
+
+    // Cache .ilmeetex (dir kosong = tidak ditulis ke disk). Thread GL, sebelum gambar pertama di-load.
+    // Kompresi dimatikan kalau driver tidak mendukung S3TC.
+    void SetCookedCache(const std::string& cacheDir, const TextureCookOptions& options);
+    const TextureCookOptions& GetCookOptions() const { return cookOptions; }
+
+    // Satu-satunya jalur decode: .ilmeetex dari cache kalau hash sumber cocok, kalau tidak decode + cook.
+    // Aman dari thread mana pun selama SetCookedCache tidak dipanggil bersamaan.
+    bool Decode(const std::string& path, DecodedImage& image) const;
+
+    // Thread GL. Load kalau belum ada dan tidak pernah dilepas (icon, background editor).
+    ImageView Get(const std::string& path, ImageVariant variant);
+    // Thread GL. Sama seperti Get tapi dengan referensi, texture dihapus saat Release terakhir kalau tidak di-pin Get.
+    ImageView Acquire(const std::string& path, ImageVariant variant);
+    // FULL yang sudah ada (+1 referensi) tanpa decode, texture 0 kalau belum di-load
+    ImageView AcquireResident(const std::string& path);
+    // Upload hasil Decode dari thread lain sebagai FULL (+1 referensi). Kalau FULL sudah ada, hasil decode dibuang.
+    ImageView Insert(DecodedImage& image);
+    // true kalau texture variant ini benar-benar dihapus
+    bool Release(const std::string& path, ImageVariant variant);
+    // Release berikutnya menghapus texture: satu referensi tersisa dan tidak di-pin Get
+    bool IsReleasable(const std::string& path, ImageVariant variant) const;
+    // Preview mip <= PreviewSize dari gambar yang sudah di-load, nullptr kalau belum.
+    // Berlaku sampai cache diubah lagi.
+    const ImagePreview* FindPreview(const std::string& path) const;
+
+    // Ganti isi gambar yang sudah di-load (pixel RGBA, baris atas dulu) tanpa baca disk, nama texture tetap
+    void Replace(const std::string& path, int width, int height, const unsigned char* pixels);
+    // Hapus semua texture, panggil sebelum GL context dihancurkan
+    void Shutdown();
+
+    const ImageCacheStats& GetStats() const { return stats; }
+    static std::string NormalizePath(const std::string& path);
+
+private:
+    struct Variant {
+        GLuint texture = 0;
+        int width = 0, height = 0;
+        uint64_t bytes = 0;
+        uint32_t refs = 0;
+        bool pinned = false;
+    };
+    struct Entry {
+        Variant full;
+        Variant thumbnail;
+        // Gambar sudah sekecil thumbnail: THUMBNAIL memakai texture FULL
+        bool thumbnailIsFull = false;
+        SpriteAlphaMode alphaMode = SpriteAlphaMode::TRANSLUCENT;
+        bool failed = false;
+        ImagePreview preview;
+    };
+
+    ImageCache() = default;
+    ImageView Load(const std::string& path, ImageVariant variant, bool pin);
+    // Upload satu variant ke texture-nya (baru kalau belum ada)
+    void Upload(Entry& entry, ImageVariant variant, const CookedTexture& cooked);
+    // Level firstLevel..akhir ke texture (baru kalau texture 0)
+    GLuint UploadLevels(GLuint texture, const CookedTexture& cooked, uint32_t firstLevel, bool thumbnail) const;
+    static uint32_t ThumbnailLevel(const CookedTexture& cooked);
+    void UpdatePreview(Entry& entry, const CookedTexture& cooked);
+    Variant& Resolve(Entry& entry, ImageVariant variant) {
+        return variant == ImageVariant::THUMBNAIL && !entry.thumbnailIsFull ? entry.thumbnail : entry.full;
+    }
+    ImageView MakeView(const Entry& entry, const Variant& variant) const;
+    void Free(Variant& variant);
+    void UpdateStats();
+
+    std::unordered_map<std::string, Entry> entries;
+    // Dibaca thread decode, hanya diubah sebelum load pertama
+    std::string cookedCacheDir = TextureCooker::DefaultCacheDir;
+    TextureCookOptions cookOptions;
+    ImageCacheStats stats;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <cstdint>
+#include "RenderQueue.hpp"
+
+enum class PickPurpose {
+    SELECT,   // Klik: ganti selection
+    HOVER     // Object di bawah kursor, request baru menggantikan yang belum dibaca
+};
+
+struct PickResult {
+    PickPurpose purpose = PickPurpose::SELECT;
+    int x = 0, y = 0;       // Pixel framebuffer, (0, 0) kiri bawah
+    int objectIndex = -1;   // Index di scene.objects, -1 = tidak ada sprite
+};
+
+// Picking lewat attachment ID (R32UI) yang ditulis pass sprite. Setiap pixel berisi posisi sprite
+// di antrian render + 1, dibaca satu pixel ke pixel-pack buffer lalu diambil beberapa frame kemudian
+// setelah fence-nya selesai, jadi CPU tidak pernah menunggu GPU dan biaya pick tidak tergantung
+// jumlah object. Sprite yang di-discard (alpha di bawah cutoff) tidak menulis ID.
+class ObjectPicker {
+public:
+    static constexpr int SlotCount = 4;
+
+    ObjectPicker() = default;
+    ~ObjectPicker();
+    ObjectPicker(const ObjectPicker&) = delete;
+    ObjectPicker& operator=(const ObjectPicker&) = delete;
+
+    void Init();
+    void Shutdown();
+
+    void Request(int x, int y, PickPurpose purpose);
+    bool HasQueued() const { return !queued.empty(); }
+
+    // Thread GL: baca pixel semua request yang antri dari attachment ID framebuffer ke PBO.
+    // queue harus urutan yang dipakai saat ID ditulis.
+    void Issue(GLuint framebuffer, int width, int height, const RenderQueue& queue);
+    // Panggil sebelum queue dibangun ulang: read yang masih di GPU menyimpan salinan urutannya
+    void PreserveOrder(const RenderQueue& queue);
+    // Thread GL: hasil yang fence-nya sudah selesai, tanpa menunggu GPU
+    void Poll(const RenderQueue& queue, std::vector<PickResult>& results);
+    // Buang request dan read yang belum selesai (mis. scene diganti)
+    void Reset();
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        PickResult request;
+        const RenderQueue* queue = nullptr;   // nullptr setelah urutannya disalin ke order
+        std::vector<uint32_t> order;
+    };
+
+    Slot slots[SlotCount];
+    std::vector<PickResult> queued;
+    std::vector<PickResult> ready;   // Request di luar viewport, hasilnya langsung kosong
+};
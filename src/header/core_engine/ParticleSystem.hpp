@@ -0,0 +1,104 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Scene.hpp"
+#include "ShaderProgram.hpp"
+#include "GLStateCache.hpp"
+#include "StreamBuffer.hpp"
+#include "TextureManager.hpp"
+#include "WorkerPool.hpp"
+
+// Data per partikel yang dibaca GPU (particle.vert), 16 byte per instance
+struct ParticleInstance {
+    float x, y;       // Pusat partikel
+    float size;
+    uint32_t color;   // RGBA8, R di byte terendah
+};
+
+struct ParticleStats {
+    uint32_t emitters = 0;
+    uint32_t liveParticles = 0;
+    uint32_t spawned = 0;     // Frame update terakhir
+    uint32_t died = 0;
+    uint32_t drawCalls = 0;
+    unsigned threads = 1;
+    float updateMs = 0.0f;
+    float writeMs = 0.0f;     // Tulis instance ke StreamBuffer
+};
+
+// Simulasi partikel CPU untuk ParticleEmitter scene. Setiap emitter punya pool structure-of-arrays
+// (satu array float per atribut) sehingga integrasi posisi, kecepatan, umur, warna dan ukuran
+// dikerjakan 4 partikel sekaligus dengan SSE2, dibagi ke WorkerPool untuk pool besar.
+// Render: semua partikel ditulis sebagai instance ke StreamBuffer, emitter berurutan dengan
+// material sama (texture + blend) digambar dengan satu glDrawElementsInstanced.
+class ParticleSystem {
+public:
+    // Pool di bawah ukuran ini di-update tanpa worker
+    static constexpr size_t MinUpdateChunk = 16384;
+    // Batas dt satu update, frame yang tersendat tidak membuat partikel melompat jauh
+    static constexpr float MaxStep = 0.1f;
+
+    ParticleSystem() = default;
+    ~ParticleSystem();
+    ParticleSystem(const ParticleSystem&) = delete;
+    ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+    void Init(GLStateCache& stateCache, StreamBuffer& streamBuffer);
+    void Shutdown();
+
+    // Majukan simulasi dt detik: integrasi, buang partikel mati, lalu spawn partikel baru.
+    // Return true kalau masih ada partikel hidup atau emitter aktif (hasil render akan berubah).
+    bool Update(const Scene& scene, float dt, WorkerPool* workers = nullptr);
+    // Gambar partikel semua emitter. Program memakai particle.vert, UBO kamera sudah di-update.
+    // fallbackTexture dipakai emitter tanpa texture.
+    void Render(const Scene& scene, ShaderProgram& program, TextureManager& textures,
+                GLuint fallbackTexture, bool overdraw, WorkerPool* workers = nullptr);
+    // Hapus semua partikel hidup
+    void Clear();
+
+    size_t GetLiveCount() const;
+    const ParticleStats& GetStats() const { return stats; }
+
+private:
+    // Structure-of-arrays, kapasitas dibulatkan ke kelipatan 4. Slot setelah count tetap berisi
+    // nilai valid supaya loop SIMD boleh memproses blok terakhir secara penuh.
+    struct Pool {
+        uint64_t id = 0;
+        size_t count = 0;
+        size_t capacity = 0;
+        std::vector<float> posX, posY, velX, velY;
+        std::vector<float> age, ageRate;   // age 0..1, ageRate = 1 / lifetime
+        std::vector<float> size, r, g, b, a;
+        float spawnAccumulator = 0.0f;
+        uint32_t random = 0x9E3779B9u;
+
+        void Reserve(size_t newCapacity);
+        void Kill(size_t index);
+    };
+
+    // Satu draw call: rentang instance berurutan dengan texture dan blend yang sama
+    struct ParticleRun {
+        GLuint texture;
+        bool additive;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    static void Integrate(Pool& pool, const ParticleEmitter& emitter, float dt, size_t begin, size_t end);
+    static void RemoveDead(Pool& pool, uint32_t& died);
+    static void Spawn(Pool& pool, const ParticleEmitter& emitter, float dt, uint32_t& spawned);
+    static void WriteInstances(const Pool& pool, ParticleInstance* out, size_t begin, size_t end);
+    void SetInstanceAttributes(GLintptr baseOffset, uint32_t firstInstance);
+
+    GLuint vao = 0, quadVBO = 0, quadEBO = 0;
+    GLStateCache* state = nullptr;
+    StreamBuffer* stream = nullptr;
+    // Pool per index scene.emitters
+    std::vector<Pool> pools;
+    std::vector<uint32_t> drawOrder;
+    std::vector<size_t> drawOffsets;
+    std::vector<ParticleRun> runs;
+    ParticleStats stats;
+};
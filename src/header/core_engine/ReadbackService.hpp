@@ -0,0 +1,66 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+// Hasil readback RGBA8, baris atas dulu (siap ditulis ke PNG)
+struct ReadbackImage {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+using ReadbackCallback = std::function<void(const ReadbackImage&)>;
+
+struct ReadbackStats {
+    uint32_t requests = 0;
+    uint32_t completed = 0;
+    uint32_t rejected = 0;        // Semua slot masih dipakai
+    uint32_t inFlight = 0;
+    uint32_t lastLatency = 0;     // Poll antara request dan hasil terakhir
+    uint64_t bytesRead = 0;
+};
+
+// Readback pixel tanpa stall: glReadPixels ke ring pixel-pack buffer, dijaga glFenceSync, dan hasilnya
+// diberikan lewat callback saat Poll menemukan fence yang sudah selesai (biasanya 1-3 frame kemudian).
+// Downscale untuk thumbnail dikerjakan pemanggil sebelum Request (pass frame graph di SceneRenderer2D).
+class ReadbackService {
+public:
+    static constexpr int SlotCount = 4;
+
+    ReadbackService() = default;
+    ~ReadbackService();
+    ReadbackService(const ReadbackService&) = delete;
+    ReadbackService& operator=(const ReadbackService&) = delete;
+
+    void Init();
+    void Shutdown();
+
+    // Thread GL, di luar pass render. Baca rect (x, y, width, height) COLOR_ATTACHMENT0 framebuffer.
+    // False kalau semua slot masih dipakai.
+    bool Request(GLuint framebuffer, int x, int y, int width, int height, ReadbackCallback callback);
+    // Thread GL, sekali per frame. wait = tunggu semua read selesai (shutdown, tool CLI).
+    void Poll(bool wait = false);
+    // Buang read yang belum selesai tanpa memanggil callback
+    void Cancel();
+
+    bool HasFreeSlot() const;
+    uint32_t GetInFlight() const { return stats.inFlight; }
+    const ReadbackStats& GetStats() const { return stats; }
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;
+        int width = 0, height = 0;
+        uint64_t requestPoll = 0;
+        ReadbackCallback callback;
+    };
+
+    Slot slots[SlotCount];
+    uint64_t pollCount = 0;
+    ReadbackStats stats;
+};
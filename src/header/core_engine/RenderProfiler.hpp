@@ -0,0 +1,79 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include "GLStateCache.hpp"
+
+enum class RenderPass {
+    GRID,
+    TILES,
+    SPRITES,
+    PARTICLES,
+    GIZMO,
+    COUNT
+};
+
+struct RenderPassStats {
+    float cpuMs = 0.0f;
+    float gpuMs = -1.0f;       // -1 selama hasil query belum tersedia
+    uint32_t drawCalls = 0;
+    uint32_t vertices = 0;
+    uint32_t textureBinds = 0;
+    uint32_t stateChanges = 0;  // Panggilan state GL yang benar-benar dikirim
+};
+
+struct RenderFrameStats {
+    uint64_t frame = 0;
+    float cpuMs = 0.0f;
+    float gpuMs = -1.0f;
+    RenderPassStats passes[(int)RenderPass::COUNT];
+};
+
+// Statistik per pass untuk SceneRenderer2D. Waktu GPU diambil dari query GL_TIME_ELAPSED
+// yang dibaca beberapa frame kemudian supaya CPU tidak menunggu GPU.
+class RenderProfiler {
+public:
+    static constexpr int PassCount = (int)RenderPass::COUNT;
+    // Jumlah frame yang boleh antri sebelum hasil query dibaca
+    static constexpr int QueryLatency = 3;
+
+    RenderProfiler() = default;
+    ~RenderProfiler();
+
+    void Init();
+    void Shutdown();
+
+    void BeginFrame(const GLStateStats& state);
+    void EndFrame();
+    void BeginPass(RenderPass pass, const GLStateStats& state);
+    void EndPass(RenderPass pass, const GLStateStats& state);
+    void AddDraws(RenderPass pass, uint32_t drawCalls, uint32_t vertices);
+
+    // Frame terakhir yang waktu GPU-nya sudah lengkap
+    const RenderFrameStats& GetStats() const { return completed; }
+
+    static const char* PassName(RenderPass pass);
+    // Overlay ImGui, dipanggil di dalam window Scene
+    void DrawOverlay() const;
+    std::string ToJson() const;
+    bool DumpToFile(const std::string& path) const;
+
+private:
+    struct Slot {
+        GLuint queries[PassCount] = {};
+        bool issued[PassCount] = {};
+        RenderFrameStats stats;
+    };
+
+    void Collect(Slot& slot);
+
+    Slot slots[QueryLatency];
+    int current = 0;
+    uint64_t frameCounter = 0;
+    bool initialized = false;
+    bool passActive = false;
+    std::chrono::steady_clock::time_point frameStart, passStart;
+    GLStateStats passStartState;
+    RenderFrameStats completed;
+};
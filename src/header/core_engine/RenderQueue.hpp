@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+struct RenderQueueStats {
+    uint32_t items = 0;
+    uint32_t changed = 0;     // Item baru, hilang atau key-nya berubah sejak frame lalu
+    uint32_t radixPasses = 0; // Pass radix yang benar-benar dijalankan (byte yang sama semua dilewati)
+    bool fullSort = false;
+    float sortMs = 0.0f;
+};
+
+// Antrian draw yang diurutkan dengan key 64-bit:
+//   [63..56] layer  [55..40] depth  [39..36] blend  [35..28] shader  [27..0] texture
+// Urutan akhir selalu (key, index object), jadi object dengan key sama tetap mengikuti urutan scene.
+// Item yang di-blend di-push dengan texture 0 supaya layer/depth yang sama digambar sesuai urutan scene,
+// hanya opaque/cutout (depth test) yang dikelompokkan per texture.
+// Kalau hanya sedikit key yang berubah, item lama dipertahankan dan yang berubah di-merge masuk.
+class RenderQueue {
+public:
+    // Layer kecil dan depth kecil digambar lebih dulu
+    static uint64_t MakeKey(int layer, float depth, uint32_t blend, uint32_t shader, uint32_t texture);
+
+    void Begin(size_t objectCount);
+    // Push harus dengan index object yang naik (mis. urutan hasil culling)
+    void Push(uint32_t index, uint64_t key);
+    void Sort();
+
+    size_t Size() const { return sorted.size(); }
+    uint32_t IndexAt(size_t i) const { return sorted[i].index; }
+    const RenderQueueStats& GetStats() const { return stats; }
+
+private:
+    struct Item {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    void RadixSort();
+    bool IncrementalSort();
+
+    std::vector<Item> items;    // Item frame ini, urutan push
+    std::vector<Item> changed;  // Item baru atau yang key-nya berubah sejak hasil terakhir
+    std::vector<Item> sorted;   // Hasil, dipakai ulang frame berikutnya
+    std::vector<Item> scratch;
+
+    // Per index object. sortedGeneration == generation berarti object ada di hasil dengan sortedKey.
+    std::vector<uint64_t> currentKey;
+    std::vector<uint32_t> pushFrame;
+    std::vector<uint32_t> sortedGeneration;
+    std::vector<uint64_t> sortedKey;
+    uint32_t frame = 0;
+    uint32_t generation = 0;
+    size_t retained = 0, keyChanged = 0;
+    size_t objectCount = 0, lastObjectCount = 0;
+
+    RenderQueueStats stats;
+};
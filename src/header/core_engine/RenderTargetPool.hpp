@@ -0,0 +1,63 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// Satu framebuffer dengan color texture RGBA8 dan depth/stencil renderbuffer.
+// Ukuran yang dialokasikan dibulatkan ke bucket, viewport hanya memakai sub-rect kiri bawah.
+struct RenderTarget {
+    GLuint framebuffer = 0;
+    GLuint colorTexture = 0;
+    GLuint depthStencil = 0;
+    GLuint idTexture = 0;      // Opsional: R32UI di COLOR_ATTACHMENT1 untuk picking
+    int allocatedWidth = 0;
+    int allocatedHeight = 0;
+    bool inUse = false;
+    uint64_t lastUsedFrame = 0; // Frame pool terakhir target ini dipakai, untuk aging
+
+    bool Fits(int width, int height) const { return width <= allocatedWidth && height <= allocatedHeight; }
+};
+
+struct RenderTargetPoolStats {
+    uint32_t allocations = 0;  // Total framebuffer yang pernah dibuat
+    uint32_t reuses = 0;       // Acquire yang dilayani target yang sudah ada
+    uint32_t live = 0;
+    uint64_t bytes = 0;        // Perkiraan memori GPU (color + depth/stencil + ID)
+};
+
+// Pool render target yang dibagi semua viewport (Scene, Game, dst).
+// Resize di dalam bucket tidak mengalokasikan apa-apa, cukup ganti viewport/scissor.
+class RenderTargetPool {
+public:
+    static constexpr int BucketStep = 256;
+    // Target bebas yang tidak dipakai selama ini dihapus oleh EndFrame (mis. sisa resize viewport)
+    static constexpr uint64_t MaxIdleFrames = 120;
+
+    static RenderTargetPool& Shared();
+
+    // Target bebas terkecil yang muat, atau buat baru dengan ukuran bucket
+    RenderTarget* Acquire(int width, int height);
+    void Release(RenderTarget* target);
+    // Tambah attachment ID (R32UI) ke target, tetap ada sampai target dihapus.
+    // Draw buffer default tetap hanya COLOR_ATTACHMENT0, pass yang menulis ID mengaktifkannya sendiri.
+    bool AttachIdBuffer(RenderTarget& target);
+    // Hapus target yang tidak dipakai
+    void Trim();
+    // Panggil sekali per frame aplikasi: majukan frame dan hapus target yang menganggur > MaxIdleFrames
+    void EndFrame();
+    // Hapus semua target, panggil sebelum GL context dihancurkan
+    void Shutdown();
+
+    static int BucketSize(int size);
+    const RenderTargetPoolStats& GetStats() const { return stats; }
+
+private:
+    RenderTargetPool() = default;
+    bool Create(RenderTarget& target, int width, int height);
+    void Destroy(RenderTarget& target);
+
+    std::vector<std::unique_ptr<RenderTarget>> targets;
+    RenderTargetPoolStats stats;
+    uint64_t frame = 0;
+};
@@ -1,6 +1,14 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <atomic>
+
+// Nomor revisi unik untuk semua scene, scene baru atau hasil load tidak pernah memakai nomor lama
+inline uint64_t NextSceneRevision() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
 
 // Simple Scene object structure
 struct GameObject {
@@ -11,9 +19,113 @@ struct GameObject {
     float rotation = 0.0f;
     float scaleX = 1.0f;
     float scaleY = 1.0f;
+    // Urutan gambar: layer kecil dulu, lalu depth kecil dulu
+    int layer = 0;
+    float depth = 0.0f;
+    // Berubah setiap spritePath diganti. Tiap renderer menyimpan handle texture sendiri per object
+    // dan me-resolve ulang kalau nomor ini beda. Ganti sprite lewat SetSpritePath,
+    // lalu Scene::MarkDirty supaya atlas ikut dicek ulang.
+    uint64_t spriteRevision = NextSceneRevision();
+
+    void SetSpritePath(const std::string& path) {
+        spritePath = path;
+        spriteRevision = NextSceneRevision();
+    }
+};
+
+// Grid tile statis. Tile disimpan sebagai index 16-bit, digambar per chunk ChunkSize x ChunkSize
+// oleh TilemapRenderer, jauh lebih hemat dari satu GameObject per tile.
+struct Tilemap {
+    static constexpr int ChunkSize = 32;
+
+    std::string name;
+    float x = 0.0f, y = 0.0f;   // Pojok kiri bawah tile (0, 0), baris 0 di bawah
+    float tileSize = 32.0f;
+    std::string tilesetPath;
+    int tilesetColumns = 1, tilesetRows = 1; // Tile ke-n di tileset dihitung dari kiri atas
+    // Tilemap digambar sebelum sprite, urut layer lalu depth
+    int layer = 0;
+    float depth = 0.0f;
+    // Dipakai renderer untuk mengenali tilemap yang sama antar frame.
+    // Perubahan posisi, ukuran tile atau tileset dideteksi renderer sendiri.
+    uint64_t id = NextSceneRevision();
+
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    int GetChunksX() const { return (width + ChunkSize - 1) / ChunkSize; }
+    int GetChunksY() const { return (height + ChunkSize - 1) / ChunkSize; }
+
+    // Isi tile dihapus, semua chunk dianggap berubah
+    void Resize(int newWidth, int newHeight) {
+        width = newWidth > 0 ? newWidth : 0;
+        height = newHeight > 0 ? newHeight : 0;
+        tiles.assign(size_t(width) * height, 0);
+        chunkRevisions.assign(size_t(GetChunksX()) * GetChunksY(), 0);
+        for (uint64_t& revision : chunkRevisions) revision = NextSceneRevision();
+    }
+
+    // 0 = kosong, n = tile ke-(n - 1) di tileset
+    uint16_t GetTile(int tx, int ty) const {
+        if (tx < 0 || ty < 0 || tx >= width || ty >= height) return 0;
+        return tiles[size_t(ty) * width + tx];
+    }
+
+    // Hanya chunk yang berisi tile ini yang di-rebuild renderer
+    void SetTile(int tx, int ty, uint16_t tile) {
+        if (tx < 0 || ty < 0 || tx >= width || ty >= height) return;
+        uint16_t& current = tiles[size_t(ty) * width + tx];
+        if (current == tile) return;
+        current = tile;
+        chunkRevisions[size_t(ty / ChunkSize) * GetChunksX() + tx / ChunkSize] = NextSceneRevision();
+    }
+
+    uint64_t GetChunkRevision(int cx, int cy) const { return chunkRevisions[size_t(cy) * GetChunksX() + cx]; }
+    const std::vector<uint16_t>& GetTiles() const { return tiles; }
+
+private:
+    int width = 0, height = 0;
+    std::vector<uint16_t> tiles;
+    std::vector<uint64_t> chunkRevisions;
+};
+
+// Sumber partikel. Partikel sendiri bukan bagian scene: disimulasikan ParticleSystem dalam pool SoA
+// dan hilang saat scene di-load ulang. Partikel disimulasikan di world space, memindah emitter
+// tidak ikut memindah partikel yang sudah lahir.
+struct ParticleEmitter {
+    std::string name;
+    float x = 0.0f, y = 0.0f;
+    std::string texturePath;         // Kosong = quad putih
+    bool additive = false;           // Blend GL_ONE untuk api, percikan, dsb.
+    bool emitting = true;
+    uint32_t maxParticles = 10000;
+    float rate = 500.0f;             // Partikel per detik
+    float lifetimeMin = 1.0f, lifetimeMax = 2.0f;
+    float speedMin = 50.0f, speedMax = 100.0f;
+    float direction = 90.0f;         // Derajat, 0 = kanan
+    float spread = 30.0f;            // Derajat ke kiri dan kanan direction
+    float gravityX = 0.0f, gravityY = -100.0f;
+    float drag = 0.0f;               // Pengurangan kecepatan per detik (0..1)
+    float startSize = 8.0f, endSize = 2.0f;
+    float startColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    float endColor[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+    // Partikel digambar setelah sprite, antar emitter urut layer lalu depth
+    int layer = 0;
+    float depth = 0.0f;
+    // Dipakai ParticleSystem untuk mengenali emitter yang sama antar frame
+    uint64_t id = NextSceneRevision();
 };
 
 struct Scene {
     std::string sceneName;
     std::vector<GameObject> objects;
+    std::vector<Tilemap> tilemaps;
+    std::vector<ParticleEmitter> emitters;
+    // Berubah setiap isi scene diedit, renderer melewati redraw kalau revisi sama
+    uint64_t revision = NextSceneRevision();
+    // Identitas scene: ikut tersalin saat scene hasil load di-assign, tidak berubah saat diedit.
+    // Index object dari scene dengan id lain tidak berlaku lagi.
+    uint64_t id = NextSceneRevision();
+
+    // Panggil setelah mengubah objects atau tile
+    void MarkDirty() { revision = NextSceneRevision(); }
 };
\ No newline at end of file
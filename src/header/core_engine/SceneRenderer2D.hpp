@@ -2,12 +2,44 @@
 #include <string>
 #include "Scene.hpp"
 #include "TextureManager.hpp"
+#include "SpriteBatch.hpp"
+#include "SpriteInstancer.hpp"
+#include "ShaderProgram.hpp"
+#include "GLStateCache.hpp"
+#include "SpriteCuller.hpp"
+#include "TextureAtlas.hpp"
+#include "RenderQueue.hpp"
+#include "RenderTargetPool.hpp"
+#include "RenderProfiler.hpp"
+#include "DebugDraw.hpp"
+#include "WorkerPool.hpp"
+#include "TilemapRenderer.hpp"
+#include "ParticleSystem.hpp"
+#include "ObjectPicker.hpp"
+#include "ReadbackService.hpp"
+#include "FrameGraph.hpp"
 #include <imgui_impl_sdl2.h>
 #include <unordered_map>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+// Waktu persiapan draw list sprite (resolve texture + sort, emit vertex) di CPU
+struct SpritePrepareStats {
+    unsigned threads = 1;
+    float resolveMs = 0.0f;
+    float emitMs = 0.0f;
+};
+
+// Jumlah sprite per kelas alpha dan overdraw terukur (sample yang lolos / pixel viewport).
+// overdraw hanya diisi selama heatmap aktif, -1 selama hasil query belum ada.
+struct SpriteOverdrawStats {
+    uint32_t solid = 0;
+    uint32_t cutout = 0;
+    uint32_t translucent = 0;
+    float overdraw = -1.0f;
+};
+
 class SceneRenderer2D {
 public:
     SceneRenderer2D(int width, int height);
@@ -15,14 +47,30 @@ public:
 
     void SetViewportSize(int width, int height);
     void RenderSceneToTexture(const Scene& scene);
+    // Tampilkan hasil render di window ImGui aktif dan tangani zoom/pan
+    void DrawViewportImage();
     void RenderScene(); // Test function
     GLuint GetViewportTextureID() const;
+    // Batas UV sub-rect viewport di dalam render target pool
+    glm::vec2 GetViewportUV() const;
+    // Capture viewport tanpa stall lewat PBO, callback dipanggil dari RenderSceneToTexture beberapa
+    // frame kemudian. Diperkecil di GPU supaya muat di maxWidth x maxHeight (aspect tetap), 0 = ukuran penuh.
+    void RequestViewportCapture(int maxWidth, int maxHeight, ReadbackCallback callback);
+    bool HasPendingCaptures() const { return !pendingCaptures.empty() || readbackService.GetInFlight() > 0; }
+    const ReadbackStats& GetReadbackStats() const { return readbackService.GetStats(); }
+    // Graph terakhir yang dijalankan (capture downscale + read)
+    const FrameGraphStats& GetFrameGraphStats() const { return frameGraph.GetStats(); }
     enum class EditMode {
         SELECT,
         MOVE,
         ROTATE,
         SCALE
     };
+    // Jalur submit sprite, bisa dipilih untuk benchmark
+    enum class SpriteRenderPath {
+        BATCHED,
+        INSTANCED
+    };
 
     // Method untuk interaksi
     void LastGridShaderProgram();
@@ -33,6 +81,29 @@ public:
     void ResetCamera();
     void SetCameraZoom(float zoom);
     void DrawSelectionGizmo(const GameObject& obj);
+    // Outline bounds semua sprite terlihat (debug)
+    void SetShowBounds(bool show) { showBounds = show; }
+    bool GetShowBounds() const { return showBounds; }
+    // Sprite opaque/cutout digambar depan-ke-belakang dengan depth write, hanya translucent yang di-blend.
+    // Dimatikan berarti semua sprite di-blend belakang-ke-depan (painter) seperti sebelumnya.
+    void SetEarlyDepth(bool enabled) { earlyDepth = enabled; }
+    bool GetEarlyDepth() const { return earlyDepth; }
+    // Heatmap overdraw: warna = jumlah fragment sprite per pixel
+    void SetShowOverdraw(bool show) { showOverdraw = show; }
+    bool GetShowOverdraw() const { return showOverdraw; }
+    // Picking lewat attachment ID yang ditulis pass sprite (akurat untuk rotasi dan alpha), hasil datang
+    // beberapa frame kemudian. Dimatikan berarti HandleClick memakai tes bounds di CPU.
+    void SetPickingEnabled(bool enabled);
+    bool GetPickingEnabled() const { return pickingEnabled; }
+    // x, y pixel framebuffer viewport, (0, 0) kiri bawah
+    void RequestPick(int x, int y, PickPurpose purpose);
+    int GetHoveredObjectIndex() const { return hoveredObjectIndex; }
+    int GetSelectedObjectIndex() const { return selectedObjectIndex; }
+    // Pick yang selesai di RenderSceneToTexture terakhir
+    const std::vector<PickResult>& GetPickResults() const { return pickResults; }
+    // Scene yang diubah HandleClick, HandleDrag, MoveSelected dan DeleteSelected.
+    // Harus scene yang sama dengan yang dirender, default currentScene.
+    void SetEditScene(Scene* scene);
 
     // Method konversi koordinat
     glm::vec2 ViewportToWorldPosition(float viewX, float viewY) const;
@@ -54,6 +125,42 @@ public:
     // Method untuk mendapatkan dimensi
     int GetWidth() const { return width; }
     int GetHeight() const { return height; }
+    const SpriteBatchStats& GetSpriteBatchStats() const;
+    void SetSpriteRenderPath(SpriteRenderPath path) { spriteRenderPath = path; }
+    SpriteRenderPath GetSpriteRenderPath() const { return spriteRenderPath; }
+    const GLStateStats& GetStateStats() const { return glState.GetStats(); }
+    const SpriteCullStats& GetCullStats() const { return spriteCuller.GetStats(); }
+    // Folder cache layout dan halaman atlas
+    void SetAtlasCacheDirectory(const std::string& dir) { atlasCacheDir = dir; atlasSceneId = 0; }
+    size_t GetAtlasPageCount() const { return textureAtlas.GetPageCount(); }
+    const RenderQueueStats& GetQueueStats() const { return renderQueue.GetStats(); }
+    const StreamBufferStats& GetStreamStats() const { return vertexStream.GetStats(); }
+    const SpritePrepareStats& GetPrepareStats() const { return prepareStats; }
+    const SpriteOverdrawStats& GetOverdrawStats() const { return overdrawStats; }
+    const TilemapStats& GetTilemapStats() const { return tilemapRenderer.GetStats(); }
+    const ParticleStats& GetParticleStats() const { return particleSystem.GetStats(); }
+    const TextureStreamStats& GetTextureStreamStats() const { return textureManager.GetStreamStats(); }
+    // Texture baru di-decode di background dan di-upload dalam budget per frame, sprite memakai placeholder
+    // sampai texture-nya siap. Prefetch otomatis saat scene berganti, bisa juga dipanggil manual.
+    void PrefetchSceneTextures(const Scene& scene);
+    void SetTextureUploadBudget(float milliseconds, size_t bytes) { textureManager.SetUploadBudget(milliseconds, bytes); }
+    // Batas VRAM texture (0 = tanpa batas), texture yang tidak terlihat di-evict lalu di-stream ulang saat terlihat lagi
+    void SetTextureMemoryBudget(uint64_t bytes) { textureManager.SetMemoryBudget(bytes); }
+    // Cache .ilmeetex texture, panggil sebelum scene pertama di-render
+    void SetTextureCookedCache(const std::string& cacheDir, const TextureCookOptions& options) { ImageCache::Shared().SetCookedCache(cacheDir, options); }
+    // Tunggu semua decode dan upload sekaligus (headless, golden test)
+    void FinishTextureStreaming();
+    // Simulasi partikel emitter scene, panggil sekali per frame sebelum RenderSceneToTexture.
+    // Selama ada partikel hidup viewport selalu di-render ulang.
+    void UpdateParticles(const Scene& scene, float dt);
+    // Paksa render ulang di frame berikutnya (mis. texture selesai di-load di luar renderer)
+    void RequestRedraw() { redrawRequested = true; }
+    bool WasLastFrameSkipped() const { return lastFrameSkipped; }
+    uint64_t GetFramesSkipped() const { return framesSkipped; }
+    // Statistik per pass (grid, sprites, gizmo), waktu GPU tertunda beberapa frame
+    const RenderFrameStats& GetFrameStats() const { return profiler.GetStats(); }
+    void DrawStatsOverlay() const { profiler.DrawOverlay(); }
+    bool DumpRenderStats(const std::string& path) const { return profiler.DumpToFile(path); }
     void InitGridBuffers();
 
     float cameraZoom = 1.0f;
@@ -62,6 +169,32 @@ public:
 
 private:
     int width, height;
+    // Ukuran baru dari ImGui, diterapkan di awal frame berikutnya
+    int pendingWidth = 0, pendingHeight = 0;
+
+    // Shadow state GL, bind yang tidak mengubah apa-apa dibuang
+    GLStateCache glState;
+    RenderProfiler profiler;
+
+    // Semua state di luar scene yang mempengaruhi isi texture viewport
+    struct ViewState {
+        float cameraX, cameraY, cameraZoom;
+        float zoom, panX, panY;
+        float gridSize;
+        float gridColor[4], bgColor[4];
+        int width, height;
+        int gridVisible, editMode, renderPath, showBounds;
+        int earlyDepth, showOverdraw;
+        const GameObject* selected;
+        float selectedX, selectedY, selectedWidth, selectedHeight;
+    };
+    ViewState CaptureViewState() const;
+    ViewState lastViewState = {};
+    uint64_t lastSceneRevision = 0;
+    uint64_t viewRevision = 0;
+    bool redrawRequested = true;
+    bool lastFrameSkipped = false;
+    uint64_t framesSkipped = 0;
 
     // Viewport attributes
     ImVec2 pan = ImVec2(0.0f, 0.0f);
@@ -73,24 +206,124 @@ private:
     ImVec4 gridColor = ImVec4(0.7f, 0.7f, 0.7f, 1.0f);
     ImVec4 bgColor = ImVec4(0.2f, 0.2f, 0.2f, 1.0f);
     
-    // Framebuffer objects
-    GLuint framebuffer;
-    GLuint textureID;      // Color attachment
-    GLuint rbo;            // Render buffer object for depth/stencil
+    // Render target dari pool bersama, bisa lebih besar dari viewport (bucket)
+    RenderTarget* renderTarget = nullptr;
     
-    // Shader program
-    GLuint vertexShader, fragmentShader;
-    GLuint shaderProgram;
-    GLuint gridShaderProgram;
-    GLuint gizmoShaderProgram;
+    // Shader program, uniform di-resolve sekali saat link
+    ShaderProgram spriteShader;
+    ShaderProgram gridShader;
+    ShaderProgram gizmoShader;
+    ShaderProgram spriteBatchShader;
+    ShaderProgram spriteInstancedShader;
+    // Varian pass opaque (tanpa discard) dan heatmap overdraw
+    ShaderProgram spriteBatchOpaqueShader;
+    ShaderProgram spriteInstancedOpaqueShader;
+    ShaderProgram spriteBatchOverdrawShader;
+    ShaderProgram spriteInstancedOverdrawShader;
+    // Projection/view dibagi semua program di atas
+    CameraUniformBuffer cameraBuffer;
     GLuint m_GridVAO, m_GridVBO;
     int m_MaxGridLines = 1000;
     
     // Quad rendering
     GLuint quadVAO = 0, quadVBO = 0, quadEBO = 0;
     
+    // Streaming vertex buffer bersama (persistent-mapped di GL 4.4)
+    StreamBuffer vertexStream;
+    // Sprite batcher, satu draw call per run texture
+    SpriteBatch spriteBatch;
+    SpriteInstancer spriteInstancer;
+    SpriteRenderPath spriteRenderPath = SpriteRenderPath::BATCHED;
+    // Line/point gizmo dalam satu ring buffer, di-flush sekali per pass gizmo
+    DebugDraw debugDraw;
+    bool showBounds = false;
+    void DrawObjectBounds(const Scene& scene);
+    // Tilemap di-bake per chunk ke buffer statis, digambar sebelum sprite
+    TilemapRenderer tilemapRenderer;
+    // Partikel CPU (SoA + SSE2), digambar setelah sprite dengan satu draw instanced per material
+    ParticleSystem particleSystem;
+    ShaderProgram particleShader;
+    ShaderProgram particleOverdrawShader;
+    GLuint particleTexture = 0;   // Putih 1x1 untuk emitter tanpa texture
+    bool particlesActive = false;
+    // Culling rect kamera sebelum submit sprite
+    SpriteCuller spriteCuller;
+    // Urutan draw berdasarkan sort key, texture dan UV di-resolve sekali per object per frame
+    struct ResolvedSprite {
+        GLuint texture = 0;
+        glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+        SpriteAlphaMode alphaMode = SpriteAlphaMode::TRANSLUCENT;
+    };
+    RenderQueue renderQueue;
+    std::vector<ResolvedSprite> resolvedSprites;
+    // Handle ke textureManager milik renderer ini, per index object. Tidak disimpan di GameObject
+    // karena scene yang sama bisa digambar beberapa renderer (Scene dan Game view).
+    struct SpriteHandle {
+        TextureHandle handle;
+        uint64_t spriteRevision = 0; // GameObject::spriteRevision saat handle di-acquire
+    };
+    std::vector<SpriteHandle> spriteHandles;
+    // Draw list dibangun paralel per chunk, thread GL hanya load texture baru, sort dan submit
+    static constexpr size_t MinPrepareChunk = 4096;
+    std::vector<std::vector<uint32_t>> missedSprites;
+    SpritePrepareStats prepareStats;
+    void PrepareSpriteList(const Scene& scene, WorkerPool& workers);
+    // Run per pass: solid dan cutout depan-ke-belakang, translucent belakang-ke-depan
+    std::vector<SpriteRun> solidRuns, cutoutRuns, translucentRuns;
+    bool earlyDepth = true;
+    void BuildSpriteRuns();
+    void DrawSpriteRuns(ShaderProgram& program, const std::vector<SpriteRun>& runs);
+    void DrawSpritePasses();
+    // Depth NDC untuk sprite ke-position dari count, sprite yang digambar belakangan lebih dekat
+    static float SpriteDepth(size_t position, size_t count) {
+        return 1.0f - 2.0f * float(position + 1) / float(count + 1);
+    }
+    // Attachment ID di render target, ditulis pass sprite selama picking aktif
+    ObjectPicker objectPicker;
+    bool pickingEnabled = false;
+    bool pickBufferValid = false;   // Attachment ID berisi frame terakhir yang dirender
+    int hoveredObjectIndex = -1;
+    std::vector<PickResult> pickResults;
+    Scene* editScene = &currentScene;
+    uint64_t editSceneId = currentScene.id;
+    // Scene di editScene berganti isi (load, new scene): selection, hover dan pick yang masih jalan dibuang
+    void SyncEditScene();
+    // nullptr kalau tidak ada selection atau index-nya sudah tidak valid
+    GameObject* GetSelectedObject() const {
+        if (editScene->id != editSceneId || selectedObjectIndex < 0 || selectedObjectIndex >= (int)editScene->objects.size()) return nullptr;
+        return &editScene->objects[selectedObjectIndex];
+    }
+    void ProcessPicks();
+    void SetPickOutput(bool enabled);
+    void SelectObject(int index);
+    int PickObjectOnCpu(float worldX, float worldY) const;
+    // Capture viewport, di-issue dari isi texture frame terakhir yang selesai dirender.
+    // Target downscale adalah transient frame graph, dibagi dengan target pool lain.
+    struct PendingCapture {
+        int maxWidth = 0, maxHeight = 0;
+        ReadbackCallback callback;
+    };
+    ReadbackService readbackService;
+    std::vector<PendingCapture> pendingCaptures;
+    bool viewportValid = false;   // Texture viewport berisi frame lengkap dengan ukuran sekarang
+    FrameGraph frameGraph;
+    void ProcessReadbacks();
+    void AddCapturePasses(FrameGraphResource viewport, PendingCapture& capture);
+    // Heatmap overdraw dan query GL_SAMPLES_PASSED untuk mengukurnya
+    bool showOverdraw = false;
+    GLuint overdrawQuery = 0;
+    bool overdrawQueryPending = false;
+    SpriteOverdrawStats overdrawStats;
+
     // Texture manager
     TextureManager textureManager;
+    // Atlas sprite scene, dibangun ulang kalau daftar sprite berubah
+    TextureAtlas textureAtlas;
+    std::string atlasCacheDir = "cache/atlas";
+    // Scene dan revisi terakhir yang dicek PrepareAtlas, plus set path sprite-nya
+    uint64_t atlasSceneId = 0;
+    uint64_t atlasSceneRevision = 0;
+    std::vector<std::string> atlasScenePaths;
     
     // Initialize components
     void Init();
@@ -98,15 +331,12 @@ private:
     void CreateFramebuffer();
     void DestroyFramebuffer();
     void InitShaders();
-    void checkProgramLinking(GLuint program);
-    
-    bool checkShaderUniforms(GLuint program);
-    void validateUniformLocation(GLuint program, const char* uniformName, const char* uniformType);
+    void PrepareAtlas(const Scene& scene);
+    // Thread GL: path sprite -> handle (region atlas atau texture sendiri), worker cukup ResolveHandle
+    TextureHandle AcquireSpriteHandle(const std::string& spritePath);
     // Helper functions
     void DrawSprite(GLuint textureID, float x, float y, float width = 64.0f, float height = 64.0f, 
                    float rotation = 0.0f, float scaleX = 1.0f, float scaleY = 1.0f);
-    GLuint LoadShaderFromFile(const std::string& path, GLenum type);
-    GLuint CreateShaderProgram(const std::string& vertPath, const std::string& fragPath);
     std::string LoadFileAsString(const std::string& path);
     GLuint CreateWhiteTexture();
     
@@ -116,6 +346,6 @@ private:
     
     // Edit properties
     EditMode currentMode = EditMode::SELECT;
-    GameObject* selectedObject = nullptr;
+    // Index, bukan pointer: vector objects bisa realokasi atau diganti saat scene di-load
     int selectedObjectIndex = -1;
 };
@@ -0,0 +1,88 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "GLStateCache.hpp"
+
+// Program shader yang uniform-nya di-resolve sekali saat link.
+// Setter bertipe menyimpan nilai terakhir dan melewati upload yang sama.
+// Setter memakai glUniform*, jadi program harus sedang aktif (Use()).
+class ShaderProgram {
+public:
+    ShaderProgram() = default;
+    ~ShaderProgram();
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+
+    bool LoadFromFiles(const std::string& vertPath, const std::string& fragPath);
+    void Destroy();
+
+    void Use() const { glUseProgram(program); }
+    void Use(GLStateCache& state) const { state.UseProgram(program); }
+    GLuint GetID() const { return program; }
+    bool IsValid() const { return program != 0; }
+
+    GLint GetUniformLocation(const char* name) const;
+    bool HasUniform(const char* name) const { return GetUniformLocation(name) != -1; }
+    // Validasi uniform wajib, cukup dipanggil sekali setelah link
+    bool RequireUniforms(const std::vector<std::pair<const char*, GLenum>>& required) const;
+    // Hubungkan uniform block (mis. "Camera") ke binding point
+    bool BindUniformBlock(const char* blockName, GLuint bindingPoint);
+
+    void SetInt(const char* name, int value);
+    void SetFloat(const char* name, float value);
+    void SetVec2(const char* name, const glm::vec2& value);
+    void SetVec3(const char* name, const glm::vec3& value);
+    void SetVec4(const char* name, const glm::vec4& value);
+    void SetMat4(const char* name, const glm::mat4& value);
+
+    // Jumlah upload yang dilewati karena nilainya sama
+    uint32_t GetSkippedUploads() const { return skippedUploads; }
+
+private:
+    struct UniformInfo {
+        std::string name;
+        GLint location = -1;
+        GLenum type = 0;
+        GLint size = 0;
+        bool hasValue = false;
+        float value[16] = {};
+    };
+
+    void Reflect();
+    UniformInfo* FindUniform(const char* name);
+    const UniformInfo* FindUniform(const char* name) const;
+    bool CacheValue(UniformInfo& uniform, const float* data, int count);
+    static GLuint CompileShader(const std::string& path, GLenum type);
+
+    GLuint program = 0;
+    std::vector<UniformInfo> uniforms;
+    uint32_t skippedUploads = 0;
+};
+
+// Data kamera yang dibagi semua program 2D lewat uniform block "Camera" (std140)
+struct CameraUniforms {
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::vec4 viewport; // width, height, zoom, unused
+};
+
+class CameraUniformBuffer {
+public:
+    static constexpr GLuint BindingPoint = 0;
+    static constexpr const char* BlockName = "Camera";
+
+    CameraUniformBuffer() = default;
+    ~CameraUniformBuffer();
+
+    void Init();
+    void Shutdown();
+    // Upload sekali per frame, dilewati kalau kamera tidak berubah
+    void Update(const glm::mat4& projection, const glm::mat4& view, float width, float height, float zoom);
+
+private:
+    GLuint ubo = 0;
+    bool hasData = false;
+    CameraUniforms current;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Klasifikasi alpha texture sprite, menentukan pass yang dipakai renderer:
+//   SOLID       semua alpha 255, digambar depan-ke-belakang dengan depth write tanpa blending
+//   CUTOUT      alpha hanya 0 atau 255, sama seperti SOLID tapi dengan alpha test
+//   TRANSLUCENT sisanya, digambar belakang-ke-depan dengan blending dan depth test saja
+// (Nama OPAQUE/TRANSPARENT tidak dipakai karena bentrok dengan macro wingdi.h)
+enum class SpriteAlphaMode : uint8_t {
+    SOLID,
+    CUTOUT,
+    TRANSLUCENT
+};
+
+// pixels berisi pixelCount pixel dengan channels komponen, alpha di komponen terakhir (2 atau 4 channel)
+inline SpriteAlphaMode ClassifyAlpha(const unsigned char* pixels, size_t pixelCount, int channels) {
+    if (channels != 2 && channels != 4) return SpriteAlphaMode::SOLID;
+
+    bool hasHoles = false;
+    for (size_t i = 0; i < pixelCount; i++) {
+        unsigned char alpha = pixels[i * channels + channels - 1];
+        if (alpha == 255) continue;
+        if (alpha != 0) return SpriteAlphaMode::TRANSLUCENT;
+        hasHoles = true;
+    }
+    return hasHoles ? SpriteAlphaMode::CUTOUT : SpriteAlphaMode::SOLID;
+}
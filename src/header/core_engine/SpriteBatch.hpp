@@ -0,0 +1,76 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "ShaderProgram.hpp"
+#include "StreamBuffer.hpp"
+
+// Satu vertex sprite yang sudah ditransform ke world space.
+// z langsung jadi depth NDC, dipakai pass opaque untuk early-Z (0 kalau depth test mati).
+struct SpriteVertex {
+    float x, y, z;
+    float u, v;
+};
+
+// Rentang sprite berurutan dengan texture yang sama, hasil draw list paralel
+struct SpriteRun {
+    GLuint texture;
+    uint32_t first;
+    uint32_t count;
+};
+
+struct SpriteBatchStats {
+    uint32_t spritesSubmitted = 0;
+    uint32_t drawCalls = 0;
+    // Draw call yang tidak perlu dikirim dibanding satu DrawSprite per object
+    uint32_t drawCallsSaved = 0;
+};
+
+// Sprite batcher: menulis quad yang sudah ditransform ke StreamBuffer bersama
+// dan flush satu draw call untuk setiap run texture/shader yang sama.
+class SpriteBatch {
+public:
+    static constexpr uint32_t MaxSprites = 16384;
+
+    SpriteBatch() = default;
+    ~SpriteBatch();
+
+    void Init(GLStateCache& stateCache, StreamBuffer& streamBuffer);
+    void Shutdown();
+
+    // Projection/view diambil dari UBO kamera yang sudah di-update per frame
+    void Begin(ShaderProgram& program);
+    void Submit(GLuint texture, float x, float y, float width, float height,
+                float rotation = 0.0f, float scaleX = 1.0f, float scaleY = 1.0f,
+                const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    void End();
+
+    // Jalur draw list: slot untuk spriteCount sprite dialokasikan di StreamBuffer,
+    // worker mengisi quad ke-i di out[i * 4] dengan WriteQuad, lalu DrawRuns di thread GL.
+    // DrawRuns boleh dipanggil beberapa kali (satu per pass) sampai BeginDirect berikutnya.
+    SpriteVertex* BeginDirect(size_t spriteCount);
+    void DrawRuns(ShaderProgram& program, const std::vector<SpriteRun>& runs);
+    // Transform satu sprite ke 4 vertex world space, aman dipanggil dari worker
+    static void WriteQuad(SpriteVertex* out, float x, float y, float width, float height,
+                          float rotation, float scaleX, float scaleY, const glm::vec4& uvRect,
+                          float depth = 0.0f);
+
+    void ResetStats() { stats = SpriteBatchStats(); }
+    const SpriteBatchStats& GetStats() const { return stats; }
+
+private:
+    void Flush();
+
+    // Vertex ada di StreamBuffer, EBO quad statis
+    GLuint vao = 0, ebo = 0;
+    ShaderProgram* currentProgram = nullptr;
+    GLuint currentTexture = 0;
+    bool inBatch = false;
+    StreamAllocation directAllocation;
+    GLStateCache* state = nullptr;
+    StreamBuffer* stream = nullptr;
+
+    std::vector<SpriteVertex> vertices;
+    SpriteBatchStats stats;
+};
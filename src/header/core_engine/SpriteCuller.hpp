@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Scene.hpp"
+#include "WorkerPool.hpp"
+
+struct SpriteCullStats {
+    uint32_t total = 0;
+    uint32_t visible = 0;
+    uint32_t culled = 0;
+    float boundsMs = 0.0f; // Waktu membangun AABB dari GameObject
+    float testMs = 0.0f;   // Waktu tes AABB terhadap rect kamera
+    uint32_t chunks = 0;   // Potongan yang dikerjakan paralel
+};
+
+// Culling sprite terhadap rect kamera. Bounds disimpan SoA (minX/minY/maxX/maxY)
+// supaya tes bisa dikerjakan 4 object sekaligus dengan SSE2.
+// Hasilnya konservatif: AABB dari rect yang dirotasi, tidak pernah membuang object yang terlihat.
+class SpriteCuller {
+public:
+    // Object per chunk paralel, di bawah ini overhead bangun thread lebih mahal dari tesnya
+    static constexpr size_t MinChunkSize = 8192;
+
+    // Isi daftar index object yang AABB-nya bersinggungan dengan rect kamera.
+    // Urutan index tetap naik, jadi urutan gambar tidak berubah.
+    // Bounds hanya dibangun ulang kalau revisi scene berubah.
+    // Dengan pool, bounds dan tes dibagi per chunk lalu hasil chunk digabung berurutan.
+    void Cull(const std::vector<GameObject>& objects, uint64_t sceneRevision, float camMinX, float camMinY, float camMaxX, float camMaxY,
+              WorkerPool* pool = nullptr);
+
+    const std::vector<uint32_t>& GetVisible() const { return visible; }
+    const SpriteCullStats& GetStats() const { return stats; }
+
+private:
+    void BuildBounds(const std::vector<GameObject>& objects, size_t begin, size_t end);
+    void TestScalar(std::vector<uint32_t>& out, size_t begin, size_t end, float camMinX, float camMinY, float camMaxX, float camMaxY) const;
+    void TestSIMD(std::vector<uint32_t>& out, size_t begin, size_t end, float camMinX, float camMinY, float camMaxX, float camMaxY) const;
+
+    std::vector<float> minX, minY, maxX, maxY;
+    std::vector<uint32_t> visible;
+    // Hasil tes per chunk, digabung ke visible sesuai urutan chunk
+    std::vector<std::vector<uint32_t>> chunkVisible;
+    uint64_t boundsRevision = 0;
+    size_t boundsCount = 0;
+    SpriteCullStats stats;
+};
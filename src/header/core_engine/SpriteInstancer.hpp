@@ -0,0 +1,58 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "SpriteBatch.hpp"
+
+// Data per-instance, model matrix dibangun di vertex shader dari field ini
+struct SpriteInstance {
+    float x, y, width, height;
+    float rotation, scaleX, scaleY, depth; // depth = z NDC untuk pass opaque
+    float u0, v0, u1, v1;
+};
+
+// Hardware-instanced sprite path: semua instance ditulis sekali per frame ke StreamBuffer lalu
+// setiap run texture digambar dengan satu glDrawElementsInstanced.
+class SpriteInstancer {
+public:
+    SpriteInstancer() = default;
+    ~SpriteInstancer();
+
+    void Init(GLStateCache& stateCache, StreamBuffer& streamBuffer);
+    void Shutdown();
+
+    // Projection/view diambil dari UBO kamera yang sudah di-update per frame
+    void Begin(ShaderProgram& program);
+    void Submit(GLuint texture, float x, float y, float width, float height,
+                float rotation = 0.0f, float scaleX = 1.0f, float scaleY = 1.0f,
+                const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    void End();
+
+    // Jalur draw list: worker mengisi out[i] dengan WriteInstance, lalu DrawRuns (per pass) di thread GL
+    SpriteInstance* BeginDirect(size_t spriteCount);
+    void DrawRuns(ShaderProgram& program, const std::vector<SpriteRun>& runs);
+    static void WriteInstance(SpriteInstance* out, float x, float y, float width, float height,
+                              float rotation, float scaleX, float scaleY, const glm::vec4& uvRect,
+                              float depth = 0.0f) {
+        *out = { x, y, width, height, rotation, scaleX, scaleY, depth, uvRect.x, uvRect.y, uvRect.z, uvRect.w };
+    }
+
+    void ResetStats() { stats = SpriteBatchStats(); }
+    const SpriteBatchStats& GetStats() const { return stats; }
+
+private:
+    void SetInstanceAttributes(GLintptr baseOffset, uint32_t firstInstance);
+
+    // Data instance ada di StreamBuffer
+    GLuint vao = 0, quadVBO = 0, quadEBO = 0;
+    ShaderProgram* currentProgram = nullptr;
+    bool inBatch = false;
+    GLStateCache* state = nullptr;
+    StreamBuffer* stream = nullptr;
+
+    std::vector<SpriteInstance> instances;
+    std::vector<SpriteRun> runs;
+    StreamAllocation directAllocation;
+    SpriteBatchStats stats;
+};
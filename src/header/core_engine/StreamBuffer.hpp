@@ -0,0 +1,95 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Potongan buffer untuk satu upload. data boleh ditulis dari thread mana saja
+// sampai Flush() dipanggil di thread GL, offset dipakai untuk attribute pointer/draw.
+struct StreamAllocation {
+    void* data = nullptr;
+    GLintptr offset = 0;
+    size_t size = 0;
+
+    bool IsValid() const { return data != nullptr; }
+};
+
+struct StreamBufferStats {
+    uint64_t bytesWritten = 0;
+    uint32_t fenceWaits = 0;     // Frame yang harus menunggu GPU selesai memakai region
+    float fenceWaitMs = 0.0f;
+    uint32_t overflows = 0;      // Frame yang kehabisan tempat di region-nya
+    uint32_t resizes = 0;
+};
+
+// Streaming vertex buffer untuk geometry dinamis (sprite batch, debug line, particle).
+// GL 4.4+: satu buffer glBufferStorage yang di-map persisten dan dibagi tiga region per frame,
+// setiap region dijaga glFenceSync sehingga CPU tidak pernah menulis data yang masih dibaca GPU.
+// GL 3.3: staging di CPU lalu upload dengan orphaning glBufferData seperti sebelumnya.
+class StreamBuffer {
+public:
+    static constexpr int RegionCount = 3;
+    static constexpr size_t DefaultRegionSize = 4 * 1024 * 1024;
+    // Batas pertumbuhan region (x RegionCount di VRAM untuk jalur persisten)
+    static constexpr size_t MaxRegionSize = 64 * 1024 * 1024;
+
+    StreamBuffer() = default;
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    bool Init(size_t regionSize = DefaultRegionSize, bool allowPersistent = true);
+    void Shutdown();
+
+    // Thread GL, awal frame: pindah ke region berikutnya dan tunggu fence-nya
+    void BeginFrame();
+    // Thread GL, setelah draw terakhir yang memakai region frame ini
+    void EndFrame();
+
+    // Thread GL, sebelum allocation besar: region diperbesar saat itu juga (kelipatan dua, sampai
+    // MaxRegionSize) supaya isi frame sejauh ini plus allocation ini muat. Storage baru berarti
+    // allocation frame ini yang belum digambar hilang, jadi panggil di antara draw.
+    // false kalau region sudah maksimum dan allocation tidak muat.
+    bool Reserve(size_t bytes, size_t alignment = 16);
+    // Thread-safe. Gagal (data == nullptr) kalau region frame ini penuh,
+    // region diperbesar di BeginFrame berikutnya.
+    StreamAllocation Allocate(size_t bytes, size_t alignment = 16);
+    // Thread GL, sebelum draw yang membaca allocation: upload staging pada jalur fallback
+    void Flush();
+
+    GLuint GetBuffer() const { return buffer; }
+    bool IsPersistent() const { return persistent; }
+    // Region penuh di frame ini, isi frame bisa tidak lengkap
+    bool HasOverflowed() const { return overflowed; }
+    size_t GetRegionSize() const { return regionSize; }
+
+    void ResetStats() { stats = StreamBufferStats(); }
+    const StreamBufferStats& GetStats() const { return stats; }
+
+private:
+    bool CreateStorage();
+    void DestroyStorage();
+    // Tunggu GPU selesai memakai semua region lalu buat storage baru dengan ukuran region ini
+    void Resize(size_t newRegionSize);
+    void WaitForRegion(int region);
+
+    GLuint buffer = 0;
+    bool persistent = false;
+    bool allowPersistent = true;
+    size_t regionSize = 0;
+    unsigned char* mapped = nullptr;
+    GLsync fences[RegionCount] = {};
+    int currentRegion = 0;
+
+    // Posisi tulis relatif ke awal region, dinaikkan secara atomik oleh Allocate
+    std::atomic<size_t> head{0};
+    // Jalur fallback: batas data yang sudah di-upload di frame ini
+    size_t flushedHead = 0;
+    bool orphanedThisFrame = false;
+    std::vector<unsigned char> staging;
+
+    std::atomic<bool> overflowed{false};
+    StreamBufferStats stats;
+};
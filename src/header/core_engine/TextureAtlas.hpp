@@ -0,0 +1,58 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "SpriteAlpha.hpp"
+
+// Posisi satu sprite di halaman atlas
+struct AtlasRegion {
+    uint32_t page = 0;
+    int x = 0, y = 0;          // Pixel, origin kiri bawah (sama dengan texture GL)
+    int width = 0, height = 0;
+    glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); // u0, v0, u1, v1
+    SpriteAlphaMode alphaMode = SpriteAlphaMode::TRANSLUCENT;
+};
+
+// Atlas sprite dengan skyline packer. Sprite kecil digabung ke beberapa halaman besar
+// supaya satu level bisa digambar dengan sedikit draw call.
+// Sprite di-decode lewat ImageCache::Decode. Layout dan pixel halaman di-cache di disk,
+// dipakai ulang selama file sumber tidak berubah.
+class TextureAtlas {
+public:
+    static constexpr int PageSize = 2048;
+    // Tepi sprite di-extrude ke gutter, cukup untuk mip sampai MaxMipLevel (2^2 <= 4)
+    static constexpr int Gutter = 4;
+    static constexpr int MaxMipLevel = 2;
+    // Sprite yang lebih besar tetap jadi texture sendiri
+    static constexpr int MaxSpriteSize = 512;
+    static constexpr int FormatVersion = 3; // 3: halaman .ilmeetex, bukan PNG
+
+    TextureAtlas() = default;
+    ~TextureAtlas();
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // Bangun atlas dari path sprite (sudah dinormalisasi). Layout diambil dari cacheDir kalau masih valid.
+    bool Build(const std::vector<std::string>& paths, const std::string& cacheDir);
+    void Clear();
+
+    // Texture halaman, UV rect dan klasifikasi alpha untuk path, false kalau sprite tidak ada di atlas
+    bool Lookup(const std::string& path, GLuint& texture, glm::vec4& uvRect, SpriteAlphaMode* alphaMode = nullptr) const;
+
+    size_t GetPageCount() const { return pages.size(); }
+    size_t GetRegionCount() const { return regions.size(); }
+    const std::vector<std::string>& GetSources() const { return sources; }
+
+private:
+    bool LoadFromCache(const std::string& layoutPath, const std::string& signature);
+    bool PackAndSave(const std::string& layoutPath, const std::string& pagePrefix, const std::string& signature);
+    GLuint UploadPage(const unsigned char* pixels);
+    void AddRegion(const std::string& path, uint32_t page, int x, int y, int width, int height, SpriteAlphaMode alphaMode);
+
+    std::unordered_map<std::string, AtlasRegion> regions;
+    std::vector<GLuint> pages;
+    std::vector<std::string> sources;
+};
@@ -0,0 +1,98 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "SpriteAlpha.hpp"
+
+// Format pixel di file .ilmeetex
+enum class CookedTextureFormat : uint32_t {
+    RGBA8,
+    BC1,    // DXT1, 4 bpp, dipakai untuk texture SOLID
+    BC3     // DXT5, 8 bpp, texture dengan alpha
+};
+
+// Layout file .ilmeetex: header, tabel mip, lalu data semua level berurutan (level 0 dulu).
+// Baris bawah dulu, sama dengan upload texture GL, jadi data bisa langsung dipakai glTexImage2D.
+struct CookedTextureHeader {
+    char magic[4];              // "ILTX"
+    uint32_t version;
+    uint64_t sourceHash;        // Hash isi file sumber, harus sama dengan nama file cache
+    uint32_t format;            // CookedTextureFormat
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+    uint32_t alphaMode;         // SpriteAlphaMode, dihitung sekali saat cook
+    uint32_t reserved;
+};
+
+struct CookedMipLevel {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;            // Dari awal file
+    uint64_t size;
+};
+
+// View ke blob .ilmeetex (mapping file atau hasil Cook), tidak memiliki datanya
+struct CookedTexture {
+    const CookedTextureHeader* header = nullptr;
+    const CookedMipLevel* levels = nullptr;
+    const unsigned char* data = nullptr;
+
+    CookedTextureFormat GetFormat() const { return CookedTextureFormat(header->format); }
+    const unsigned char* GetLevelData(uint32_t level) const { return data + levels[level].offset; }
+    // Ukuran semua level, dipakai untuk budget upload dan residency
+    uint64_t GetTotalBytes() const;
+};
+
+struct TextureCookOptions {
+    // Kompres ke BC1/BC3 di CPU. Lossy, matikan kalau driver tidak punya S3TC.
+    bool compress = false;
+};
+
+// File read-only yang di-map ke memori, data di-upload langsung dari mapping
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+    const unsigned char* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// Cooker texture: decode + mip chain + kompresi dilakukan sekali, file cache di-key dengan hash isi sumber
+// jadi sumber yang berubah otomatis memakai file baru
+class TextureCooker {
+public:
+    static constexpr uint32_t FormatVersion = 1;
+    static constexpr const char* DefaultCacheDir = "cache/textures";
+
+    // FNV-1a 64 bit atas isi file
+    static uint64_t HashBytes(const unsigned char* data, size_t size);
+    static std::string GetCachePath(const std::string& cacheDir, uint64_t sourceHash, const TextureCookOptions& options);
+
+    // pixels RGBA8 baris bawah dulu -> blob .ilmeetex lengkap
+    static std::vector<unsigned char> Cook(const unsigned char* pixels, int width, int height, SpriteAlphaMode alphaMode,
+                                           uint64_t sourceHash, const TextureCookOptions& options);
+    // false kalau blob rusak, versi lama atau hash sumber tidak cocok
+    static bool Parse(const unsigned char* data, size_t size, uint64_t sourceHash, CookedTexture& texture);
+    // Satu level ke RGBA8 baris bawah dulu (BC di-decode di CPU), untuk level kecil seperti preview
+    static bool DecodeLevel(const CookedTexture& texture, uint32_t level, std::vector<unsigned char>& pixels);
+    // Tulis lewat file sementara supaya decoder lain tidak pernah membaca file setengah jadi
+    static bool WriteCacheFile(const std::string& path, const std::vector<unsigned char>& blob);
+    static bool ReadFile(const std::string& path, std::vector<unsigned char>& bytes);
+
+    static bool IsCookable(const std::string& path);
+};
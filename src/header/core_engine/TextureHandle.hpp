@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+
+// Referensi ke slot texture di TextureManager: index tabel padat + generation slot saat handle dibuat.
+// Generation 0 = belum di-resolve. Handle basi (slot sudah dipakai ulang) dikenali dari generation yang beda.
+struct TextureHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return generation != 0; }
+};
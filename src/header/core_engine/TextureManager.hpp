@@ -2,24 +2,174 @@
 
 #include <GLHeader.hpp>
 #include <string>
+#include <vector>
+#include <deque>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 #include <stb_image.h>
+#include <glm/glm.hpp>
+#include "SpriteAlpha.hpp"
+#include "TextureHandle.hpp"
+#include "ImageCache.hpp"
+
+struct TextureStreamStats {
+    uint32_t queued = 0;             // Menunggu atau sedang di-decode
+    uint32_t ready = 0;              // Sudah di-decode, menunggu budget upload
+    uint32_t uploadedLastFrame = 0;
+    uint64_t uploadedBytesLastFrame = 0;
+    float uploadMs = 0.0f;
+    uint32_t totalUploaded = 0;
+    uint32_t failed = 0;
+    uint32_t cookedHits = 0;         // Di-upload langsung dari .ilmeetex di cache
+    uint32_t cooked = 0;             // Di-decode dari sumber lalu di-cook (ditulis ke cache kalau aktif)
+    // Residency: texture asli di VRAM (placeholder tidak dihitung), termasuk mip chain
+    uint32_t residentTextures = 0;
+    uint64_t residentBytes = 0;
+    uint64_t budgetBytes = 0;
+    uint32_t evictedLastFrame = 0;
+    uint32_t totalEvicted = 0;
+    uint32_t restreamed = 0;          // Texture yang di-evict lalu dibutuhkan lagi
+};
+
+// Hasil resolve satu path sprite: texture sendiri (UV penuh) atau region di halaman atlas
+struct TextureSlot {
+    GLuint texture = 0;   // 0 = file tidak ada atau gagal di-decode
+    glm::vec4 uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    SpriteAlphaMode alphaMode = SpriteAlphaMode::TRANSLUCENT;
+    uint32_t generation = 1;
+    uint32_t refs = 0;            // Jumlah AcquireHandle sejak InvalidateHandles
+    uint64_t lastUsedFrame = 0;   // Frame residency terakhir sprite-nya digambar
+    bool region = false;  // Diisi pemanggil (atlas), tidak diubah streaming
+    bool evicted = false; // Texture di-evict, di-stream ulang saat handle dipakai lagi
+};
 
 class TextureManager {
 public:
     TextureManager() = default;
     ~TextureManager();
-    
-    // Load texture from file, returning the texture ID
+
+    // Load texture from file, returning the texture ID (blocking, decode + upload di thread ini)
     GLuint LoadTexture(const std::string& path);
-    
+
+    // Versi streaming: texture kalau sudah ada, placeholder selama file di-decode di background,
+    // 0 kalau file tidak ada atau gagal di-decode. Tidak pernah menunggu disk.
+    GLuint RequestTexture(const std::string& path);
+    // Hint: mulai decode path ini sekarang (mis. semua texture scene setelah load)
+    void Prefetch(const std::vector<std::string>& paths);
+    // Thread GL, sekali per frame di luar pass render: upload hasil decode sampai budget habis
+    // (minimal satu texture). Return jumlah texture di cache yang berubah.
+    size_t ProcessUploads();
+    // Tunggu semua decode lalu upload tanpa budget (headless, capture)
+    size_t FinishStreaming();
+    void SetUploadBudget(float milliseconds, size_t bytes) { uploadBudgetMs = milliseconds; uploadBudgetBytes = bytes; }
+    bool IsStreaming() const { return !pendingPaths.empty(); }
+    // Texture abu-abu kotak-kotak yang dipakai selama decode. Buat di luar frame, upload-nya mengubah binding.
+    GLuint GetPlaceholderTexture();
+    const TextureStreamStats& GetStreamStats() const { return streamStats; }
+
+    // Thread GL: resolve path sekali ke handle. Texture di-stream seperti RequestTexture dan slot
+    // ikut berganti dari placeholder ke texture asli, jadi handle tidak perlu di-resolve ulang.
+    TextureHandle AcquireHandle(const std::string& path);
+    // Handle untuk region texture milik pemanggil (mis. sprite di halaman atlas)
+    TextureHandle AcquireRegionHandle(const std::string& path, GLuint texture, const glm::vec4& uvRect, SpriteAlphaMode alphaMode);
+    // Semua handle jadi basi (atlas dibangun ulang, cache di-clear), slot dipakai ulang
+    void InvalidateHandles();
+    // Tanpa string dan tanpa lock, aman dari worker selama tidak ada Acquire/Invalidate bersamaan.
+    // nullptr kalau handle belum di-resolve atau basi.
+    const TextureSlot* ResolveHandle(TextureHandle handle) const {
+        if (handle.index >= textureSlots.size()) return nullptr;
+        const TextureSlot& slot = textureSlots[handle.index];
+        return slot.generation == handle.generation ? &slot : nullptr;
+    }
+    // Thread GL: sprite handle ini digambar frame ini, texture yang sudah di-evict mulai di-stream ulang
+    void TouchHandle(TextureHandle handle) {
+        if (handle.index >= textureSlots.size()) return;
+        TextureSlot& slot = textureSlots[handle.index];
+        if (slot.generation != handle.generation) return;
+        slot.lastUsedFrame = residencyFrame;
+        if (slot.evicted) RestreamSlot(handle.index);
+    }
+    size_t GetHandleCount() const { return slotIndices.size(); }
+
+    // Batas memori texture (0 = tanpa batas). Kalau lewat, texture yang tidak dipegang handle di-evict
+    // dulu (LRU), lalu texture ber-handle yang paling lama tidak terlihat. Texture frame terakhir dan texture
+    // yang juga dipegang pemakai ImageCache lain tidak pernah di-evict.
+    void SetMemoryBudget(uint64_t bytes) { memoryBudget = bytes; }
+    uint64_t GetMemoryBudget() const { return memoryBudget; }
+    // Thread GL, sekali per frame yang di-render sebelum pass dimulai: evict sampai di bawah budget
+    // lalu mulai frame residency baru. Return jumlah texture yang di-evict.
+    size_t UpdateResidency();
+
     // Get texture ID for already loaded texture
     GLuint GetTexture(const std::string& path) const;
-    
+
+    // Sama seperti GetTexture tapi tanpa log, aman dipanggil dari worker selama cache tidak diubah
+    GLuint FindTexture(const std::string& path, SpriteAlphaMode* alphaMode = nullptr) const;
+
     // Clear all loaded textures
     void ClearTextures();
-    // Cache of loaded textures (path -> textureID)
+    // Cache of loaded textures (path -> textureID), path yang masih di-decode menunjuk placeholder.
+    // Texture asli milik ImageCache, setiap path di sini memegang satu referensi FULL.
     std::unordered_map<std::string, GLuint> textureCache;
+    // Klasifikasi alpha per texture, dihitung sekali saat load
+    std::unordered_map<std::string, SpriteAlphaMode> alphaModes;
 
 private:
-};
\ No newline at end of file
+    struct DecodeJob {
+        std::string path;
+        uint64_t generation = 0;
+    };
+
+    static std::string NormalizePath(const std::string& path);
+    // Masukkan hasil decode ke cache, false kalau hasilnya sudah tidak dibutuhkan
+    bool FinishImage(DecodedImage& image);
+    void QueueDecode(const std::string& normalizedPath);
+    void DecoderLoop();
+    TextureHandle AllocateSlot(const std::string& normalizedPath, const TextureSlot& value);
+    void RestreamSlot(uint32_t index);
+    // Texture baru masuk cache (upload streaming atau LoadTexture)
+    void TrackResident(const std::string& normalizedPath, uint64_t bytes);
+    // true kalau texture-nya benar-benar dihapus dari VRAM
+    bool EvictTexture(const std::string& normalizedPath);
+    // Texture path berubah (upload selesai, gagal, load sinkron): slot non-region ikut diperbarui
+    void UpdateSlot(const std::string& normalizedPath);
+
+    // Thread decode dibuat saat request pertama
+    std::vector<std::thread> decoders;
+    std::mutex streamMutex;
+    std::condition_variable streamWake;
+    std::condition_variable streamIdle;
+    std::deque<DecodeJob> decodeQueue;
+    std::vector<DecodedImage> decodedImages;
+    uint32_t decoding = 0;
+    bool stopping = false;
+
+    // Hanya thread GL
+    std::deque<DecodedImage> uploadQueue;
+    std::unordered_set<std::string> pendingPaths;
+    std::unordered_set<std::string> failedPaths;
+    uint64_t streamGeneration = 0;
+    GLuint placeholderTexture = 0;
+    // Tabel handle: slot padat, path -> index, dan slot bebas setelah InvalidateHandles
+    std::vector<TextureSlot> textureSlots;
+    std::vector<std::string> slotPaths;
+    std::unordered_map<std::string, uint32_t> slotIndices;
+    std::vector<uint32_t> freeSlots;
+    // Residency per texture asli: ukuran dan frame terakhir dipakai lewat path (tileset, emitter)
+    struct Residency {
+        uint64_t bytes = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+    std::unordered_map<std::string, Residency> residency;
+    std::unordered_set<std::string> evictedPaths;
+    uint64_t residencyFrame = 1;
+    uint64_t memoryBudget = 512ull << 20;
+    float uploadBudgetMs = 2.0f;
+    size_t uploadBudgetBytes = 16u << 20;
+    TextureStreamStats streamStats;
+};
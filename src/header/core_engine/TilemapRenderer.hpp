@@ -0,0 +1,74 @@
+#pragma once
+#include <GLHeader.hpp>
+#include <vector>
+#include <cstdint>
+#include "Scene.hpp"
+#include "SpriteBatch.hpp"
+#include "ShaderProgram.hpp"
+#include "GLStateCache.hpp"
+#include "TextureManager.hpp"
+
+struct TilemapStats {
+    uint32_t visibleChunks = 0;
+    uint32_t chunksBuilt = 0;    // Chunk yang di-bake ulang frame ini
+    uint32_t drawCalls = 0;
+    uint32_t tilesDrawn = 0;
+    uint32_t residentChunks = 0; // Chunk yang punya vertex buffer di GPU
+    uint64_t gpuBytes = 0;
+};
+
+// Renderer tilemap statis: setiap chunk Tilemap::ChunkSize x ChunkSize di-bake sekali ke vertex buffer
+// GL_STATIC_DRAW dan digambar dengan satu draw call. Chunk hanya di-bake ulang kalau terlihat dan
+// revisinya berubah; chunk yang lama tidak terlihat dilepas dari GPU.
+class TilemapRenderer {
+public:
+    static constexpr int ChunkTiles = Tilemap::ChunkSize * Tilemap::ChunkSize;
+    // Jumlah frame render tanpa terlihat sebelum buffer chunk dilepas
+    static constexpr uint64_t MaxIdleFrames = 600;
+
+    TilemapRenderer() = default;
+    ~TilemapRenderer();
+    TilemapRenderer(const TilemapRenderer&) = delete;
+    TilemapRenderer& operator=(const TilemapRenderer&) = delete;
+
+    void Init(GLStateCache& stateCache);
+    void Shutdown();
+
+    // Gambar tilemap scene yang masuk rect kamera (world space), urut layer lalu depth.
+    // Program memakai format SpriteVertex (sprite_batch.vert), UBO kamera sudah di-update.
+    void Render(const Scene& scene, TextureManager& textures, ShaderProgram& program,
+                float minX, float minY, float maxX, float maxY);
+    // Lepas semua vertex buffer chunk
+    void Clear();
+
+    const TilemapStats& GetStats() const { return stats; }
+
+private:
+    struct Chunk {
+        GLuint vbo = 0;
+        uint32_t tileCount = 0;
+        uint64_t revision = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    // Cache per index scene.tilemaps. Layout saat di-bake disimpan, kalau berubah semua chunk di-bake ulang.
+    struct MapCache {
+        uint64_t id = 0;
+        float x = 0.0f, y = 0.0f, tileSize = 0.0f;
+        int width = 0, height = 0, columns = 0, rows = 0;
+        std::vector<Chunk> chunks;
+    };
+
+    bool LayoutChanged(const MapCache& cache, const Tilemap& map) const;
+    void ResetCache(MapCache& cache, const Tilemap& map);
+    void BuildChunk(const Tilemap& map, int cx, int cy, Chunk& chunk);
+    void ReleaseChunk(Chunk& chunk);
+
+    GLuint vao = 0, ebo = 0;
+    GLStateCache* state = nullptr;
+    std::vector<MapCache> caches;
+    std::vector<uint32_t> drawOrder;
+    std::vector<SpriteVertex> scratch;
+    uint64_t frame = 0;
+    TilemapStats stats;
+};
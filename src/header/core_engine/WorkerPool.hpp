@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+// Pool thread tetap untuk pekerjaan data-parallel di renderer (culling, resolve, emit vertex).
+// Thread pemanggil ikut mengerjakan chunk, jadi pool dengan N worker memakai N + 1 core.
+// Fungsi job tidak boleh memanggil GL.
+class WorkerPool {
+public:
+    // Dibagi semua renderer, jumlah worker = core - 1
+    static WorkerPool& Shared();
+
+    explicit WorkerPool(unsigned workerCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Jumlah thread yang mengerjakan job, termasuk pemanggil
+    unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Jumlah chunk yang dipakai ParallelFor untuk count item, dipakai untuk menyiapkan output per chunk.
+    // Batas chunk selalu kelipatan alignment (mis. 4 untuk SIMD).
+    size_t ChunkCount(size_t count, size_t minChunkSize, size_t alignment = 1) const;
+
+    // Panggil job(chunk, begin, end) untuk setiap chunk [0, count) dan tunggu sampai semua selesai.
+    // Chunk kecil atau pool tanpa worker dikerjakan langsung di thread pemanggil.
+    void ParallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t, size_t, size_t)>& job, size_t alignment = 1);
+
+private:
+    size_t ChunkSize(size_t count, size_t minChunkSize, size_t alignment) const;
+    void WorkerLoop();
+    void RunChunks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool stopping = false;
+    uint64_t generation = 0;
+
+    // Job yang sedang berjalan, hanya satu ParallelFor dalam satu waktu
+    std::mutex submitMutex;
+    const std::function<void(size_t, size_t, size_t)>* currentJob = nullptr;
+    size_t jobCount = 0, jobChunkSize = 0, jobChunks = 0;
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<size_t> finishedChunks{0};
+    unsigned activeWorkers = 0;
+};
@@ -147,8 +147,17 @@ public:
         int height;
     };
     IconInfo GenerateVideoThumbnail(const std::string& videoPath);
+    // Thumbnail video (gambar biasa lewat ImageCache)
     std::unordered_map<std::string, IconInfo> iconCacheInfo;
     IconInfo LoadCachedTexture(const string& pathIcon);
+    // Ganti isi icon yang sudah di-cache (pixel RGBA, baris atas dulu) tanpa load ulang dari disk
+    void RefreshCachedIcon(const std::string& path, int width, int height, const unsigned char* pixels);
+    // Thumbnail scene hasil capture viewport editor
+    std::string GetSceneThumbnailPath(const std::string& scenePath) const {
+        return "cache/thumbnails/" + fs::path(scenePath).stem().string() + ".png";
+    }
+    // Path thumbnail -> ada di disk. Dicek sekali, di-set true oleh RefreshCachedIcon setelah capture
+    std::unordered_map<std::string, bool> sceneThumbnailExists;
     
     IconInfo GetIconForFile(const AssetFile& node) {
         std::string path = "assets/images/fileicons/";
@@ -170,7 +179,15 @@ public:
             }
             else if (ext == ".fbx" || ext == ".obj") path += "file.png";
             else if (ext == ".prefab") path += "file.png";
-            else if (ext == ".ilmeescene" || ext == ".unity") path += "file.png";
+            else if (ext == ".ilmeescene") {
+                std::string thumbnail = GetSceneThumbnailPath(node.fullPath);
+                auto exists = sceneThumbnailExists.find(thumbnail);
+                if (exists == sceneThumbnailExists.end()) {
+                    exists = sceneThumbnailExists.emplace(thumbnail, fs::exists(thumbnail)).first;
+                }
+                path = exists->second ? thumbnail : path + "file.png";
+            }
+            else if (ext == ".unity") path += "file.png";
             else path += "file.png";
         }
 
@@ -242,7 +259,6 @@ public:
     std::vector<Notification> notifications;
     Assets assets;
     TextureData icon_texture_data;
-    std::unordered_map<std::string, ImTextureID> iconCache;
     ImTextureID GetCachedIcon(const std::string& path);
     // File monitoring system
     std::thread fileWatcherThread;
@@ -112,6 +112,7 @@ public:
     bool showExplorer = true;
     bool showInspector = true;
     bool showScene = true;
+    bool showRenderStats = false;
     bool showConsole = true;
     bool showHierarchy = true;
     bool showMainView = true;
@@ -142,10 +143,7 @@ public:
         "Shun (Small)",
         "Hanako (Swimsuit)"
     };
-    GLuint blurFBO, blurTexture;
     int screenWidth, screenHeight;
-    int blurWidth = screenWidth / 4;
-    int blurHeight = screenHeight / 4;
    
     bool processVideoPacket(AVPacket* pkt);
     void processAudioPacket(AVPacket* pkt);
@@ -168,6 +166,9 @@ public:
     void RenderSceneWindow();
     void RenderHierarchyWindow();
     void RenderSceneToolbarView(ImVec2 viewportPos, ImVec2 viewportSize);
+    // Capture viewport async (PBO), ditulis ke PNG saat hasilnya datang
+    void SaveSceneScreenshot();
+    void CaptureSceneThumbnail(const std::string& scenePath);
     void RenderPlayMenu();
     void PushMessage(const std::string& message);
     
@@ -35,7 +35,7 @@ class Assets {
 public:
     float r, g, b;
     // Color dominantColor;
-    Color GetDominantColor(unsigned char* data, int width, int height, int channels);
+    Color GetDominantColor(const unsigned char* data, int width, int height, int channels);
     // Assets();
     // ~Assets();
 
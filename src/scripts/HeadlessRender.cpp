@@ -0,0 +1,408 @@
+// Render .ilmeescene tanpa window: benchmark FPS dan regression test gambar.
+// Contoh (dijalankan dari folder build supaya assets/shaders ditemukan):
+//   HeadlessRender scene.ilmeescene --frames 300 --size 1280x720 --out out.png --golden goldens/scene.png
+// Exit code: 0 = OK, 1 = error, 2 = hasil berbeda dengan golden.
+#include <HeadlessContext.hpp>
+#include <SceneRenderer2D.hpp>
+#include <SceneSerializer.hpp>
+#include <Debugger.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <stb_image_write.h>
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <filesystem>
+using namespace std;
+
+struct HeadlessOptions {
+    string scenePath;
+    string outputPath = "headless_output.png";
+    string goldenPath;
+    string statsPath;
+    int width = 1280;
+    int height = 720;
+    int frames = 120;
+    int warmupFrames = 5;
+    // Selisih per channel yang masih dianggap sama (rasterizer/driver berbeda sedikit)
+    int tolerance = 2;
+    // Persentase pixel yang boleh melewati tolerance
+    double maxDiffPercent = 0.1;
+    bool updateGolden = false;
+    bool showBounds = false;
+    bool instanced = false;
+    bool showOverdraw = false;
+    bool earlyDepth = true;
+    bool pick = false;
+    int pickX = 0, pickY = 0;
+    string thumbnailPath;
+    int thumbnailWidth = 0, thumbnailHeight = 0;
+    // MB, negatif = default TextureManager
+    int textureBudgetMB = -1;
+    string textureCacheDir = TextureCooker::DefaultCacheDir;
+    bool compressTextures = false;
+};
+
+struct ImageDiff {
+    uint64_t mismatched = 0;
+    int maxDelta = 0;
+    double meanDelta = 0.0;
+};
+
+static void PrintUsage(const char* exe) {
+    cout << "Usage: " << exe << " <scene.ilmeescene> [options]\n"
+         << "  --frames N            Frames to render for the benchmark (default 120)\n"
+         << "  --warmup N            Untimed frames before the benchmark (default 5)\n"
+         << "  --size WxH            Viewport size (default 1280x720)\n"
+         << "  --out PATH            Output PNG (default headless_output.png)\n"
+         << "  --golden PATH         Compare the output against this PNG\n"
+         << "  --tolerance N         Per-channel difference ignored by the diff (default 2)\n"
+         << "  --max-diff-percent P  Allowed percentage of differing pixels (default 0.1)\n"
+         << "  --update-golden       Write the output to --golden instead of comparing\n"
+         << "  --stats PATH          Dump per-pass render stats as JSON\n"
+         << "  --show-bounds         Draw sprite bounds through DebugDraw\n"
+         << "  --instanced           Use the instanced sprite path instead of the batcher\n"
+         << "  --overdraw            Render the overdraw heatmap and report samples per pixel\n"
+         << "  --no-early-z          Blend every sprite back-to-front (no opaque depth pass)\n"
+         << "  --pick X,Y            Pick the sprite under framebuffer pixel X,Y (origin bottom-left) via the ID buffer\n"
+         << "  --thumbnail WxH PATH  Also write a GPU-downscaled capture that fits in WxH\n"
+         << "  --texture-budget MB   Texture memory budget before LRU eviction (0 = unlimited)\n"
+         << "  --texture-cache DIR   Cooked .ilmeetex cache directory (default cache/textures, \"none\" to decode sources)\n"
+         << "  --compress-textures   Cook textures to BC1/BC3 instead of RGBA8\n";
+}
+
+static bool ParseArgs(int argc, char* argv[], HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        } else if (arg == "--frames" && hasValue) {
+            options.frames = max(1, atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmupFrames = max(0, atoi(argv[++i]));
+        } else if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 || options.width <= 0 || options.height <= 0) {
+                cerr << "Invalid --size, expected WxH" << endl;
+                return false;
+            }
+        } else if (arg == "--out" && hasValue) {
+            options.outputPath = argv[++i];
+        } else if (arg == "--golden" && hasValue) {
+            options.goldenPath = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            options.tolerance = max(0, atoi(argv[++i]));
+        } else if (arg == "--max-diff-percent" && hasValue) {
+            options.maxDiffPercent = max(0.0, atof(argv[++i]));
+        } else if (arg == "--update-golden") {
+            options.updateGolden = true;
+        } else if (arg == "--show-bounds") {
+            options.showBounds = true;
+        } else if (arg == "--instanced") {
+            options.instanced = true;
+        } else if (arg == "--overdraw") {
+            options.showOverdraw = true;
+        } else if (arg == "--no-early-z") {
+            options.earlyDepth = false;
+        } else if (arg == "--pick" && hasValue) {
+            if (sscanf(argv[++i], "%d,%d", &options.pickX, &options.pickY) != 2) {
+                cerr << "Invalid --pick, expected X,Y" << endl;
+                return false;
+            }
+            options.pick = true;
+        } else if (arg == "--thumbnail" && i + 2 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &options.thumbnailWidth, &options.thumbnailHeight) != 2
+                || options.thumbnailWidth <= 0 || options.thumbnailHeight <= 0) {
+                cerr << "Invalid --thumbnail, expected WxH PATH" << endl;
+                return false;
+            }
+            options.thumbnailPath = argv[++i];
+        } else if (arg == "--stats" && hasValue) {
+            options.statsPath = argv[++i];
+        } else if (arg == "--texture-budget" && hasValue) {
+            options.textureBudgetMB = max(0, atoi(argv[++i]));
+        } else if (arg == "--texture-cache" && hasValue) {
+            options.textureCacheDir = argv[++i];
+            if (options.textureCacheDir == "none") options.textureCacheDir.clear();
+        } else if (arg == "--compress-textures") {
+            options.compressTextures = true;
+        } else if (!arg.empty() && arg[0] != '-' && options.scenePath.empty()) {
+            options.scenePath = arg;
+        } else {
+            cerr << "Unknown argument: " << arg << endl;
+            return false;
+        }
+    }
+    return !options.scenePath.empty();
+}
+
+static ImageDiff CompareImages(const unsigned char* a, const unsigned char* b, int width, int height, int tolerance, vector<unsigned char>& diffImage) {
+    ImageDiff diff;
+    uint64_t totalDelta = 0;
+    size_t pixelCount = size_t(width) * height;
+    diffImage.assign(pixelCount * 4, 0);
+
+    for (size_t i = 0; i < pixelCount; i++) {
+        int pixelDelta = 0;
+        for (int c = 0; c < 4; c++) {
+            int delta = abs(int(a[i * 4 + c]) - int(b[i * 4 + c]));
+            pixelDelta = max(pixelDelta, delta);
+            totalDelta += delta;
+        }
+        diff.maxDelta = max(diff.maxDelta, pixelDelta);
+
+        // Gambar diff: pixel yang beda merah, sisanya hasil render yang digelapkan
+        unsigned char* out = &diffImage[i * 4];
+        if (pixelDelta > tolerance) {
+            diff.mismatched++;
+            out[0] = 255; out[1] = 0; out[2] = 0;
+        } else {
+            out[0] = a[i * 4 + 0] / 4;
+            out[1] = a[i * 4 + 1] / 4;
+            out[2] = a[i * 4 + 2] / 4;
+        }
+        out[3] = 255;
+    }
+    diff.meanDelta = pixelCount ? double(totalDelta) / (pixelCount * 4) : 0.0;
+    return diff;
+}
+
+static string DiffImagePath(const string& outputPath) {
+    filesystem::path path(outputPath);
+    return (path.parent_path() / (path.stem().string() + "_diff.png")).string();
+}
+
+static int CheckGolden(const HeadlessOptions& options, const vector<unsigned char>& pixels) {
+    if (options.updateGolden) {
+        filesystem::path golden(options.goldenPath);
+        if (golden.has_parent_path()) filesystem::create_directories(golden.parent_path());
+        if (!stbi_write_png(options.goldenPath.c_str(), options.width, options.height, 4, pixels.data(), options.width * 4)) {
+            cerr << "Error: Could not write golden image: " << options.goldenPath << endl;
+            return 1;
+        }
+        Debug::Logger::Log("Golden image updated: " + options.goldenPath, Debug::LogLevel::SUCCESS);
+        return 0;
+    }
+
+    // Texture sprite di-load terbalik, golden dibaca apa adanya (baris atas dulu).
+    // Flag per thread: ImageCache::Decode memasang flip thread-local yang mengalahkan flag global.
+    stbi_set_flip_vertically_on_load_thread(0);
+    int goldenWidth = 0, goldenHeight = 0, channels = 0;
+    unsigned char* golden = stbi_load(options.goldenPath.c_str(), &goldenWidth, &goldenHeight, &channels, 4);
+    if (!golden) {
+        cerr << "Error: Could not load golden image: " << options.goldenPath << " (" << stbi_failure_reason() << ")" << endl;
+        return 1;
+    }
+    if (goldenWidth != options.width || goldenHeight != options.height) {
+        cerr << "Golden size mismatch: " << goldenWidth << "x" << goldenHeight
+             << " vs output " << options.width << "x" << options.height << endl;
+        stbi_image_free(golden);
+        return 2;
+    }
+
+    vector<unsigned char> diffImage;
+    ImageDiff diff = CompareImages(pixels.data(), golden, options.width, options.height, options.tolerance, diffImage);
+    stbi_image_free(golden);
+
+    double diffPercent = 100.0 * diff.mismatched / (double(options.width) * options.height);
+    cout << "Golden diff: " << diff.mismatched << " pixels (" << diffPercent << "%), max delta "
+         << diff.maxDelta << ", mean delta " << diff.meanDelta << endl;
+
+    if (diffPercent > options.maxDiffPercent) {
+        string diffPath = DiffImagePath(options.outputPath);
+        stbi_write_png(diffPath.c_str(), options.width, options.height, 4, diffImage.data(), options.width * 4);
+        Debug::Logger::Log("Output differs from golden, diff written to " + diffPath, Debug::LogLevel::CRASH);
+        return 2;
+    }
+    Debug::Logger::Log("Output matches golden", Debug::LogLevel::SUCCESS);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    HeadlessOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (!filesystem::exists(options.scenePath)) {
+        cerr << "Error: Scene file does not exist: " << options.scenePath << endl;
+        return 1;
+    }
+
+    HeadlessContext context;
+    if (!context.Create()) {
+        Debug::Logger::Log("Failed to create headless OpenGL context", Debug::LogLevel::CRASH);
+        return 1;
+    }
+
+    int exitCode = 0;
+    {
+        // Renderer harus dihancurkan sebelum context
+        SceneSerializer serializer;
+        Scene scene = serializer.LoadScene(options.scenePath);
+        SceneRenderer2D renderer(options.width, options.height);
+        renderer.SetShowBounds(options.showBounds);
+        if (options.instanced) renderer.SetSpriteRenderPath(SceneRenderer2D::SpriteRenderPath::INSTANCED);
+        renderer.SetShowOverdraw(options.showOverdraw);
+        renderer.SetEarlyDepth(options.earlyDepth);
+        renderer.SetPickingEnabled(options.pick);
+        if (options.textureBudgetMB >= 0) renderer.SetTextureMemoryBudget(uint64_t(options.textureBudgetMB) << 20);
+        TextureCookOptions cookOptions;
+        cookOptions.compress = options.compressTextures;
+        renderer.SetTextureCookedCache(options.textureCacheDir, cookOptions);
+
+        // Frame pertama membangun atlas dan memulai decode texture, tunggu semuanya supaya hasil deterministik
+        renderer.RenderSceneToTexture(scene);
+        auto streamStart = chrono::steady_clock::now();
+        renderer.FinishTextureStreaming();
+        const TextureStreamStats& streaming = renderer.GetTextureStreamStats();
+        cout << "Texture streaming: " << streaming.totalUploaded << " textures uploaded (" << streaming.cookedHits << " from cache, "
+             << streaming.cooked << " cooked)  " << streaming.failed << " failed  ("
+             << chrono::duration<double, milli>(chrono::steady_clock::now() - streamStart).count() << " ms wait)" << endl;
+
+        // Warmup: atlas, texture dan shader cache driver tidak ikut diukur
+        for (int i = 0; i < options.warmupFrames; i++) {
+            renderer.RequestRedraw();
+            // Step tetap 60 Hz supaya hasil partikel sama setiap run
+            renderer.UpdateParticles(scene, 1.0f / 60.0f);
+            renderer.RenderSceneToTexture(scene);
+        }
+        glFinish();
+
+        // glFinish per frame supaya waktu yang diukur termasuk kerja GPU (llvmpipe)
+        vector<double> frameMs;
+        frameMs.reserve(options.frames);
+        auto benchStart = chrono::steady_clock::now();
+        for (int i = 0; i < options.frames; i++) {
+            auto frameStart = chrono::steady_clock::now();
+            renderer.RequestRedraw();
+            // Step tetap 60 Hz supaya hasil partikel sama setiap run
+            renderer.UpdateParticles(scene, 1.0f / 60.0f);
+            renderer.RenderSceneToTexture(scene);
+            RenderTargetPool::Shared().EndFrame();
+            glFinish();
+            frameMs.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - frameStart).count());
+        }
+        double totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - benchStart).count();
+
+        sort(frameMs.begin(), frameMs.end());
+        double p95 = frameMs[min(frameMs.size() - 1, size_t(frameMs.size() * 0.95))];
+        cout << "Scene: " << scene.sceneName << " (" << scene.objects.size() << " objects) at "
+             << options.width << "x" << options.height << " on " << context.GetRendererName() << endl;
+        cout << "Frames: " << options.frames << "  avg " << totalMs / options.frames << " ms  ("
+             << 1000.0 * options.frames / totalMs << " FPS)  min " << frameMs.front()
+             << " ms  p95 " << p95 << " ms  max " << frameMs.back() << " ms" << endl;
+
+        const SpriteCullStats& cull = renderer.GetCullStats();
+        cout << "Visible sprites: " << cull.visible << "/" << cull.total << "  atlas pages: " << renderer.GetAtlasPageCount() << endl;
+        const StreamBufferStats& stream = renderer.GetStreamStats();
+        cout << "Stream buffer: " << stream.bytesWritten / 1024 << " KB written  fence waits " << stream.fenceWaits
+             << " (" << stream.fenceWaitMs << " ms)  resizes " << stream.resizes << endl;
+        const SpritePrepareStats& prepare = renderer.GetPrepareStats();
+        cout << "Sprite prepare: " << prepare.threads << " threads  resolve " << prepare.resolveMs
+             << " ms  emit " << prepare.emitMs << " ms" << endl;
+        if (!scene.tilemaps.empty()) {
+            const TilemapStats& tiles = renderer.GetTilemapStats();
+            cout << "Tilemaps: " << scene.tilemaps.size() << "  visible chunks " << tiles.visibleChunks
+                 << "  draw calls " << tiles.drawCalls << "  tiles " << tiles.tilesDrawn
+                 << "  resident chunks " << tiles.residentChunks << " (" << tiles.gpuBytes / 1024 << " KB)" << endl;
+        }
+        const TextureStreamStats& residency = renderer.GetTextureStreamStats();
+        cout << "Texture residency: " << residency.residentTextures << " textures  " << residency.residentBytes / 1024
+             << " KB / " << residency.budgetBytes / 1024 << " KB budget  evicted " << residency.totalEvicted
+             << "  re-streamed " << residency.restreamed << endl;
+        if (!scene.emitters.empty()) {
+            const ParticleStats& particles = renderer.GetParticleStats();
+            cout << "Particles: " << particles.liveParticles << " live in " << particles.emitters << " emitters  update "
+                 << particles.updateMs << " ms  write " << particles.writeMs << " ms  draw calls " << particles.drawCalls
+                 << "  (" << particles.threads << " threads)" << endl;
+        }
+        const SpriteOverdrawStats& overdraw = renderer.GetOverdrawStats();
+        cout << "Sprite classes: " << overdraw.solid << " opaque  " << overdraw.cutout << " cutout  "
+             << overdraw.translucent << " translucent  early-z " << (options.earlyDepth ? "on" : "off");
+        if (overdraw.overdraw >= 0.0f) cout << "  overdraw " << overdraw.overdraw << "x";
+        cout << endl;
+
+        if (options.pick) {
+            // Scene tidak berubah jadi frame berikutnya dilewati, pick tetap dibaca dari attachment ID terakhir
+            renderer.SetEditScene(&scene);
+            renderer.RequestPick(options.pickX, options.pickY, PickPurpose::SELECT);
+            int waited = 0;
+            bool resolved = false;
+            for (; waited < 10 && !resolved; waited++) {
+                renderer.RenderSceneToTexture(scene);
+                glFinish();
+                resolved = !renderer.GetPickResults().empty();
+            }
+            int picked = renderer.GetSelectedObjectIndex();
+            cout << "Pick (" << options.pickX << ", " << options.pickY << "): ";
+            if (!resolved) cout << "no result";
+            else if (picked < 0) cout << "no object";
+            else cout << "object " << picked << " '" << scene.objects[picked].name << "'";
+            cout << " after " << waited << " frames" << endl;
+        }
+
+        if (!options.statsPath.empty()) {
+            renderer.DumpRenderStats(options.statsPath);
+        }
+
+        // Capture lewat PBO seperti editor, frame berikutnya dilewati jadi isi viewport tetap sama
+        ReadbackImage output, thumbnail;
+        bool outputReady = false, thumbnailReady = options.thumbnailPath.empty();
+        renderer.RequestViewportCapture(0, 0, [&](const ReadbackImage& image) { output = image; outputReady = true; });
+        if (!thumbnailReady) {
+            renderer.RequestViewportCapture(options.thumbnailWidth, options.thumbnailHeight,
+                [&](const ReadbackImage& image) { thumbnail = image; thumbnailReady = true; });
+        }
+        int waited = 0;
+        for (; waited < 10 && !(outputReady && thumbnailReady); waited++) {
+            renderer.RenderSceneToTexture(scene);
+            glFinish();
+        }
+        const ReadbackStats& readback = renderer.GetReadbackStats();
+        cout << "Readback: " << readback.completed << "/" << readback.requests << " captures after " << waited
+             << " frames  " << readback.bytesRead / 1024 << " KB read" << endl;
+        const FrameGraphStats& graph = renderer.GetFrameGraphStats();
+        if (graph.transientTargets > 0) {
+            cout << "Frame graph: " << graph.passes << " passes (" << graph.culledPasses << " culled)  transient targets "
+                 << graph.transientTargets << " on " << graph.physicalTargets << " physical  "
+                 << graph.physicalBytes / 1024 << "/" << graph.transientBytes / 1024 << " KB" << endl;
+        }
+
+        if (!outputReady) {
+            Debug::Logger::Log("Failed to read back the viewport", Debug::LogLevel::CRASH);
+            exitCode = 1;
+        } else if (!stbi_write_png(options.outputPath.c_str(), output.width, output.height, 4, output.pixels.data(), output.width * 4)) {
+            cerr << "Error: Could not write output image: " << options.outputPath << endl;
+            exitCode = 1;
+        } else {
+            cout << "Output written to " << options.outputPath << endl;
+            if (!options.goldenPath.empty()) {
+                exitCode = CheckGolden(options, output.pixels);
+            }
+        }
+
+        if (!options.thumbnailPath.empty()) {
+            if (thumbnailReady && stbi_write_png(options.thumbnailPath.c_str(), thumbnail.width, thumbnail.height, 4,
+                                                 thumbnail.pixels.data(), thumbnail.width * 4)) {
+                cout << "Thumbnail " << thumbnail.width << "x" << thumbnail.height << " written to " << options.thumbnailPath << endl;
+            } else {
+                cerr << "Error: Could not write thumbnail: " << options.thumbnailPath << endl;
+                exitCode = 1;
+            }
+        }
+    }
+
+    RenderTargetPool::Shared().Shutdown();
+    ImageCache::Shared().Shutdown();
+    context.Destroy();
+    return exitCode;
+}
@@ -0,0 +1,166 @@
+#include <DebugDraw.hpp>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+DebugDraw::~DebugDraw() {
+    Shutdown();
+}
+
+void DebugDraw::Init(GLStateCache& stateCache, StreamBuffer& streamBuffer) {
+    state = &stateCache;
+    stream = &streamBuffer;
+
+    // Position (vec2) dan color (RGBA8 -> vec4), pointer diatur di Flush dengan offset StreamBuffer.
+    // Stride 12 byte, allocation di-align ke stride supaya glDrawArrays bisa memakai first.
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+}
+
+void DebugDraw::Shutdown() {
+    if (vao) {
+        if (state) state->ForgetVertexArray(vao);
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+    Clear();
+}
+
+uint32_t DebugDraw::PackColor(const glm::vec4& color) {
+    auto channel = [](float value) -> uint32_t {
+        return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    // Urutan byte di memori R, G, B, A (little endian)
+    return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(color.w) << 24);
+}
+
+void DebugDraw::Line(const glm::vec2& a, const glm::vec2& b, const glm::vec4& color) {
+    uint32_t packed = PackColor(color);
+    lines.push_back({ a.x, a.y, packed });
+    lines.push_back({ b.x, b.y, packed });
+}
+
+void DebugDraw::Rect(const glm::vec2& min, const glm::vec2& max, const glm::vec4& color) {
+    uint32_t packed = PackColor(color);
+    const DebugVertex corners[4] = {
+        { min.x, min.y, packed },
+        { max.x, min.y, packed },
+        { max.x, max.y, packed },
+        { min.x, max.y, packed }
+    };
+    for (int i = 0; i < 4; i++) {
+        lines.push_back(corners[i]);
+        lines.push_back(corners[(i + 1) % 4]);
+    }
+}
+
+void DebugDraw::RotatedRect(const glm::vec2& center, const glm::vec2& halfSize, float rotation, const glm::vec4& color) {
+    if (rotation == 0.0f) {
+        Rect(glm::vec2(center.x - halfSize.x, center.y - halfSize.y), glm::vec2(center.x + halfSize.x, center.y + halfSize.y), color);
+        return;
+    }
+
+    float radians = glm::radians(rotation);
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    const float local[4][2] = {
+        { -halfSize.x, -halfSize.y },
+        {  halfSize.x, -halfSize.y },
+        {  halfSize.x,  halfSize.y },
+        { -halfSize.x,  halfSize.y }
+    };
+
+    uint32_t packed = PackColor(color);
+    DebugVertex corners[4];
+    for (int i = 0; i < 4; i++) {
+        corners[i] = { center.x + local[i][0] * c - local[i][1] * s,
+                       center.y + local[i][0] * s + local[i][1] * c, packed };
+    }
+    for (int i = 0; i < 4; i++) {
+        lines.push_back(corners[i]);
+        lines.push_back(corners[(i + 1) % 4]);
+    }
+}
+
+void DebugDraw::Circle(const glm::vec2& center, float radius, const glm::vec4& color, int segments) {
+    segments = std::max(segments, 3);
+    uint32_t packed = PackColor(color);
+
+    // Putar vektor radius per segmen, cukup satu sin/cos per circle
+    float step = 2.0f * 3.14159265f / segments;
+    float c = std::cos(step);
+    float s = std::sin(step);
+    float dx = radius, dy = 0.0f;
+    for (int i = 0; i < segments; i++) {
+        float nx = dx * c - dy * s;
+        float ny = dx * s + dy * c;
+        lines.push_back({ center.x + dx, center.y + dy, packed });
+        lines.push_back({ center.x + nx, center.y + ny, packed });
+        dx = nx;
+        dy = ny;
+    }
+}
+
+void DebugDraw::Point(const glm::vec2& position, const glm::vec4& color) {
+    points.push_back({ position.x, position.y, PackColor(color) });
+}
+
+void DebugDraw::Clear() {
+    lines.clear();
+    points.clear();
+}
+
+GLint DebugDraw::Upload(const vector<DebugVertex>& vertices, uint32_t count) {
+    StreamAllocation allocation = stream->Allocate(count * sizeof(DebugVertex), sizeof(DebugVertex));
+    if (!allocation.IsValid()) return -1;
+    memcpy(allocation.data, vertices.data(), allocation.size);
+    return static_cast<GLint>(allocation.offset / sizeof(DebugVertex));
+}
+
+void DebugDraw::Flush(ShaderProgram& program) {
+    if (IsEmpty() || !vao) {
+        Clear();
+        return;
+    }
+
+    // Semua line dan point ditulis dulu, lalu satu Flush sebelum draw
+    uint32_t lineCount = std::min<uint32_t>(static_cast<uint32_t>(lines.size()), MaxVertices & ~1u);
+    uint32_t pointCount = std::min<uint32_t>(static_cast<uint32_t>(points.size()), MaxVertices);
+    // Ruang untuk keduanya dipastikan sebelum upload pertama, Reserve bisa mengganti storage
+    stream->Reserve((size_t(lineCount) + pointCount + 1) * sizeof(DebugVertex), sizeof(DebugVertex));
+    GLint firstLine = lineCount ? Upload(lines, lineCount) : -1;
+    GLint firstPoint = pointCount ? Upload(points, pointCount) : -1;
+    stream->Flush();
+
+    program.Use(*state);
+    state->BindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->GetBuffer());
+    // Offset 0, vertex pertama dipilih lewat argumen first glDrawArrays
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, x));
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, color));
+
+    if (firstLine >= 0) {
+        glEnable(GL_LINE_SMOOTH);
+        glLineWidth(lineWidth);
+        glDrawArrays(GL_LINES, firstLine, lineCount);
+        glDisable(GL_LINE_SMOOTH);
+        stats.lineVertices += lineCount;
+        stats.drawCalls++;
+    }
+
+    if (firstPoint >= 0) {
+        glPointSize(pointSize);
+        glDrawArrays(GL_POINTS, firstPoint, pointCount);
+        stats.pointVertices += pointCount;
+        stats.drawCalls++;
+    }
+
+    Clear();
+}
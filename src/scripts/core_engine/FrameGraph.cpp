@@ -0,0 +1,210 @@
+#include <FrameGraph.hpp>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <Debugger.hpp>
+
+using namespace std;
+
+void FrameGraph::Reset() {
+    resources.clear();
+    passes.clear();
+    order.clear();
+}
+
+FrameGraphResource FrameGraph::ImportTarget(const char* name, RenderTarget* target, int width, int height) {
+    Resource resource;
+    resource.name = name;
+    resource.width = width;
+    resource.height = height;
+    resource.target = target;
+    resource.imported = true;
+    resources.push_back(move(resource));
+    return FrameGraphResource(resources.size() - 1);
+}
+
+FrameGraphResource FrameGraph::CreateTarget(const char* name, int width, int height) {
+    Resource resource;
+    resource.name = name;
+    resource.width = max(width, 1);
+    resource.height = max(height, 1);
+    resources.push_back(move(resource));
+    return FrameGraphResource(resources.size() - 1);
+}
+
+FrameGraphPass FrameGraph::AddPass(const char* name, FrameGraphExecute execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = move(execute);
+    passes.push_back(move(pass));
+    return FrameGraphPass(passes.size() - 1);
+}
+
+void FrameGraph::Read(FrameGraphPass pass, FrameGraphResource resource) {
+    passes[pass].reads.push_back(resource);
+}
+
+void FrameGraph::Write(FrameGraphPass pass, FrameGraphResource resource) {
+    passes[pass].writes.push_back(resource);
+    resources[resource].writers.push_back(pass);
+}
+
+void FrameGraph::SetSideEffect(FrameGraphPass pass) {
+    passes[pass].sideEffect = true;
+}
+
+void FrameGraph::Cull() {
+    // Reference counting dari output: transient yang tidak dibaca membuat penulisnya tidak berguna,
+    // dan pass yang dibuang mengurangi pembaca resource yang dibacanya
+    for (Resource& resource : resources) resource.readers = 0;
+    for (Pass& pass : passes) {
+        pass.culled = false;
+        pass.outputs = uint32_t(pass.writes.size());
+        for (FrameGraphResource resource : pass.reads) resources[resource].readers++;
+    }
+
+    vector<FrameGraphResource> unused;
+    auto cullPass = [&](Pass& pass) {
+        pass.culled = true;
+        for (FrameGraphResource resource : pass.reads) {
+            if (--resources[resource].readers == 0 && !resources[resource].imported) unused.push_back(resource);
+        }
+    };
+    for (Pass& pass : passes) {
+        if (pass.outputs == 0 && !pass.sideEffect) cullPass(pass);
+    }
+    for (size_t i = 0; i < resources.size(); i++) {
+        if (resources[i].readers == 0 && !resources[i].imported) unused.push_back(FrameGraphResource(i));
+    }
+
+    while (!unused.empty()) {
+        FrameGraphResource resource = unused.back();
+        unused.pop_back();
+        for (FrameGraphPass writer : resources[resource].writers) {
+            Pass& pass = passes[writer];
+            if (pass.culled) continue;
+            if (--pass.outputs == 0 && !pass.sideEffect) cullPass(pass);
+        }
+    }
+}
+
+bool FrameGraph::Sort() {
+    // Pembaca menunggu semua penulis resource, penulis resource yang sama tetap urutan deklarasi
+    vector<vector<FrameGraphPass>> successors(passes.size());
+    dependencies.assign(passes.size(), 0);
+    auto addEdge = [&](FrameGraphPass from, FrameGraphPass to) {
+        successors[from].push_back(to);
+        dependencies[to]++;
+    };
+    for (FrameGraphPass p = 0; p < passes.size(); p++) {
+        if (passes[p].culled) continue;
+        for (FrameGraphResource resource : passes[p].reads) {
+            for (FrameGraphPass writer : resources[resource].writers) {
+                if (writer != p && !passes[writer].culled) addEdge(writer, p);
+            }
+        }
+    }
+    for (const Resource& resource : resources) {
+        FrameGraphPass previous = FrameGraphPass(-1);
+        for (FrameGraphPass writer : resource.writers) {
+            if (passes[writer].culled) continue;
+            if (previous != FrameGraphPass(-1) && previous != writer) addEdge(previous, writer);
+            previous = writer;
+        }
+    }
+
+    // Kahn, dari pass siap dipilih yang paling awal dideklarasikan supaya urutan stabil
+    priority_queue<FrameGraphPass, vector<FrameGraphPass>, greater<FrameGraphPass>> ready;
+    size_t alive = 0;
+    for (FrameGraphPass p = 0; p < passes.size(); p++) {
+        if (passes[p].culled) continue;
+        alive++;
+        if (dependencies[p] == 0) ready.push(p);
+    }
+    while (!ready.empty()) {
+        FrameGraphPass pass = ready.top();
+        ready.pop();
+        order.push_back(pass);
+        for (FrameGraphPass next : successors[pass]) {
+            if (--dependencies[next] == 0) ready.push(next);
+        }
+    }
+    return order.size() == alive;
+}
+
+void FrameGraph::ComputeLifetimes() {
+    for (Resource& resource : resources) resource.firstUse = resource.lastUse = -1;
+    for (int position = 0; position < int(order.size()); position++) {
+        const Pass& pass = passes[order[position]];
+        auto use = [&](FrameGraphResource id) {
+            Resource& resource = resources[id];
+            if (resource.firstUse < 0) resource.firstUse = position;
+            resource.lastUse = position;
+        };
+        for (FrameGraphResource id : pass.reads) use(id);
+        for (FrameGraphResource id : pass.writes) use(id);
+    }
+}
+
+bool FrameGraph::Execute() {
+    stats = FrameGraphStats();
+    stats.passes = uint32_t(passes.size());
+    order.clear();
+
+    Cull();
+    if (!Sort()) {
+        Debug::Logger::Log("[FrameGraph] Dependency cycle, graph skipped", Debug::LogLevel::WARNING);
+        return false;
+    }
+    stats.culledPasses = stats.passes - uint32_t(order.size());
+    ComputeLifetimes();
+
+    RenderTargetPool& pool = RenderTargetPool::Shared();
+    vector<RenderTarget*> physical;
+    bool complete = true;
+    for (int position = 0; position < int(order.size()) && complete; position++) {
+        Pass& pass = passes[order[position]];
+
+        // Transient dibuat tepat sebelum dipakai, target yang baru dilepas pass sebelumnya dipakai ulang
+        auto acquire = [&](FrameGraphResource id) {
+            Resource& resource = resources[id];
+            if (resource.imported || resource.firstUse != position || resource.target) return;
+            resource.target = pool.Acquire(resource.width, resource.height);
+            if (!resource.target) {
+                Debug::Logger::Log(string("[FrameGraph] Failed to acquire target ") + resource.name, Debug::LogLevel::WARNING);
+                complete = false;
+                return;
+            }
+            uint64_t bytes = uint64_t(resource.target->allocatedWidth) * resource.target->allocatedHeight * 8;
+            stats.transientTargets++;
+            stats.transientBytes += bytes;
+            if (find(physical.begin(), physical.end(), resource.target) == physical.end()) {
+                physical.push_back(resource.target);
+                stats.physicalBytes += bytes;
+            }
+        };
+        for (FrameGraphResource id : pass.reads) acquire(id);
+        for (FrameGraphResource id : pass.writes) acquire(id);
+        if (!complete) break;
+
+        if (pass.execute) pass.execute(*this);
+
+        auto release = [&](FrameGraphResource id) {
+            Resource& resource = resources[id];
+            if (resource.imported || resource.lastUse != position || !resource.target) return;
+            pool.Release(resource.target);
+            resource.target = nullptr;
+        };
+        for (FrameGraphResource id : pass.reads) release(id);
+        for (FrameGraphResource id : pass.writes) release(id);
+    }
+    stats.physicalTargets = uint32_t(physical.size());
+
+    // Gagal di tengah: transient yang masih dipegang dikembalikan
+    for (Resource& resource : resources) {
+        if (resource.imported || !resource.target) continue;
+        pool.Release(resource.target);
+        resource.target = nullptr;
+    }
+    return complete;
+}
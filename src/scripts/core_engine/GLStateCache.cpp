@@ -0,0 +1,144 @@
+#include <GLStateCache.hpp>
+
+void GLStateCache::BeginFrame() {
+    stats = GLStateStats();
+    Invalidate();
+}
+
+void GLStateCache::Invalidate() {
+    framebuffer = Unknown;
+    program = Unknown;
+    vertexArray = Unknown;
+    activeUnit = Unknown;
+    for (int i = 0; i < MaxTextureUnits; i++) textures[i] = Unknown;
+    blendEnabled = -1;
+    blendSrc = blendDst = Unknown;
+    depthTestEnabled = -1;
+    depthMaskEnabled = -1;
+    viewport[0] = viewport[1] = viewport[2] = viewport[3] = -1;
+    scissorEnabled = -1;
+    scissor[0] = scissor[1] = scissor[2] = scissor[3] = -1;
+    clearColor[0] = clearColor[1] = clearColor[2] = clearColor[3] = -1.0f;
+}
+
+bool GLStateCache::Changed(bool same) {
+    if (same) {
+        stats.dropped++;
+        return false;
+    }
+    stats.issued++;
+    return true;
+}
+
+void GLStateCache::BindFramebuffer(GLuint fbo) {
+    if (!Changed(framebuffer == fbo)) return;
+    framebuffer = fbo;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+}
+
+void GLStateCache::UseProgram(GLuint id) {
+    if (!Changed(program == id)) return;
+    program = id;
+    glUseProgram(id);
+}
+
+void GLStateCache::BindVertexArray(GLuint vao) {
+    if (!Changed(vertexArray == vao)) return;
+    vertexArray = vao;
+    glBindVertexArray(vao);
+}
+
+void GLStateCache::BindTexture(GLuint unit, GLuint texture) {
+    if (unit >= MaxTextureUnits) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        activeUnit = unit;
+        stats.issued += 2;
+        stats.textureBinds++;
+        return;
+    }
+    if (!Changed(textures[unit] == texture)) return;
+
+    if (Changed(activeUnit == unit)) {
+        activeUnit = unit;
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    textures[unit] = texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    stats.textureBinds++;
+}
+
+void GLStateCache::SetBlend(bool enabled) {
+    if (!Changed(blendEnabled == (enabled ? 1 : 0))) return;
+    blendEnabled = enabled ? 1 : 0;
+    if (enabled) glEnable(GL_BLEND);
+    else glDisable(GL_BLEND);
+}
+
+void GLStateCache::SetBlendFunc(GLenum src, GLenum dst) {
+    if (!Changed(blendSrc == src && blendDst == dst)) return;
+    blendSrc = src;
+    blendDst = dst;
+    glBlendFunc(src, dst);
+}
+
+void GLStateCache::SetDepthTest(bool enabled) {
+    if (!Changed(depthTestEnabled == (enabled ? 1 : 0))) return;
+    depthTestEnabled = enabled ? 1 : 0;
+    if (enabled) glEnable(GL_DEPTH_TEST);
+    else glDisable(GL_DEPTH_TEST);
+}
+
+void GLStateCache::SetDepthMask(bool enabled) {
+    if (!Changed(depthMaskEnabled == (enabled ? 1 : 0))) return;
+    depthMaskEnabled = enabled ? 1 : 0;
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+}
+
+void GLStateCache::SetViewport(GLint x, GLint y, GLsizei w, GLsizei h) {
+    if (!Changed(viewport[0] == x && viewport[1] == y && viewport[2] == w && viewport[3] == h)) return;
+    viewport[0] = x;
+    viewport[1] = y;
+    viewport[2] = w;
+    viewport[3] = h;
+    glViewport(x, y, w, h);
+}
+
+void GLStateCache::SetScissorTest(bool enabled) {
+    if (!Changed(scissorEnabled == (enabled ? 1 : 0))) return;
+    scissorEnabled = enabled ? 1 : 0;
+    if (enabled) glEnable(GL_SCISSOR_TEST);
+    else glDisable(GL_SCISSOR_TEST);
+}
+
+void GLStateCache::SetScissor(GLint x, GLint y, GLsizei w, GLsizei h) {
+    if (!Changed(scissor[0] == x && scissor[1] == y && scissor[2] == w && scissor[3] == h)) return;
+    scissor[0] = x;
+    scissor[1] = y;
+    scissor[2] = w;
+    scissor[3] = h;
+    glScissor(x, y, w, h);
+}
+
+void GLStateCache::SetClearColor(float r, float g, float b, float a) {
+    if (!Changed(clearColor[0] == r && clearColor[1] == g && clearColor[2] == b && clearColor[3] == a)) return;
+    clearColor[0] = r;
+    clearColor[1] = g;
+    clearColor[2] = b;
+    clearColor[3] = a;
+    glClearColor(r, g, b, a);
+}
+
+void GLStateCache::ForgetVertexArray(GLuint vao) {
+    if (vertexArray == vao) vertexArray = Unknown;
+}
+
+void GLStateCache::ForgetTexture(GLuint texture) {
+    for (int i = 0; i < MaxTextureUnits; i++) {
+        if (textures[i] == texture) textures[i] = Unknown;
+    }
+}
+
+void GLStateCache::ForgetFramebuffer(GLuint fbo) {
+    if (framebuffer == fbo) framebuffer = Unknown;
+}
@@ -0,0 +1,103 @@
+#include <HeadlessContext.hpp>
+#include <iostream>
+#include <Debugger.hpp>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+using namespace std;
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+HeadlessContext::~HeadlessContext() {
+    Destroy();
+}
+
+static EGLDisplay OpenDisplay() {
+    // Surfaceless Mesa tidak butuh X11/Wayland maupun /dev/dri
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) return display;
+    }
+
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) return display;
+    return EGL_NO_DISPLAY;
+}
+
+bool HeadlessContext::Create(int major, int minor) {
+    if (context) return true;
+
+    EGLDisplay eglDisplay = OpenDisplay();
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        cerr << "[HeadlessContext] Failed to initialize EGL display (error 0x" << hex << eglGetError() << dec << ")" << endl;
+        return false;
+    }
+    display = eglDisplay;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        cerr << "[HeadlessContext] Desktop OpenGL is not supported by this EGL implementation" << endl;
+        Destroy();
+        return false;
+    }
+
+    // Config tidak wajib untuk context surfaceless, tapi sebagian driver lama tetap memintanya
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        config = nullptr;
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, major,
+        EGL_CONTEXT_MINOR_VERSION, minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttribs);
+    if (eglContext == EGL_NO_CONTEXT) {
+        cerr << "[HeadlessContext] Failed to create OpenGL " << major << "." << minor
+             << " core context (error 0x" << hex << eglGetError() << dec << ")" << endl;
+        Destroy();
+        return false;
+    }
+    context = eglContext;
+
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        cerr << "[HeadlessContext] eglMakeCurrent failed, EGL_KHR_surfaceless_context is required" << endl;
+        Destroy();
+        return false;
+    }
+
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        cerr << "[HeadlessContext] Failed to initialize GLAD" << endl;
+        Destroy();
+        return false;
+    }
+
+    Debug::Logger::Log("[HeadlessContext] OpenGL " + string((const char*)glGetString(GL_VERSION)) + " on " + GetRendererName(), Debug::LogLevel::SUCCESS);
+    return true;
+}
+
+void HeadlessContext::Destroy() {
+    if (!display) return;
+    EGLDisplay eglDisplay = (EGLDisplay)display;
+    eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context) eglDestroyContext(eglDisplay, (EGLContext)context);
+    eglTerminate(eglDisplay);
+    context = nullptr;
+    display = nullptr;
+}
+
+string HeadlessContext::GetRendererName() const {
+    if (!context) return "";
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    return renderer ? string((const char*)renderer) : "";
+}
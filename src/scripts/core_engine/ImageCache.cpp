@@ -0,0 +1,317 @@
+#include <ImageCache.hpp>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <stb_image.h>
+#include <Debugger.hpp>
+
+using namespace std;
+
+// Enum EXT_texture_compression_s3tc, tidak ikut di loader GL core
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+ImageCache& ImageCache::Shared() {
+    static ImageCache cache;
+    return cache;
+}
+
+string ImageCache::NormalizePath(const string& path) {
+    string normalizedPath = path;
+    replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
+    return normalizedPath;
+}
+
+void ImageCache::SetCookedCache(const string& cacheDir, const TextureCookOptions& options) {
+    cookedCacheDir = cacheDir;
+    cookOptions = options;
+    if (!cookOptions.compress) return;
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    vector<GLint> formats(max(count, 0));
+    if (count > 0) glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    bool bc1 = find(formats.begin(), formats.end(), GL_COMPRESSED_RGB_S3TC_DXT1_EXT) != formats.end();
+    bool bc3 = find(formats.begin(), formats.end(), GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) != formats.end();
+    if (!bc1 || !bc3) {
+        Debug::Logger::Log("[ImageCache] S3TC not supported, cooked textures stay RGBA8", Debug::LogLevel::WARNING);
+        cookOptions.compress = false;
+    }
+}
+
+bool ImageCache::Decode(const string& path, DecodedImage& image) const {
+    // Verify file exists before attempting to load
+    if (!filesystem::exists(path)) {
+        cerr << "ERROR: File does not exist: " << path << endl;
+        return false;
+    }
+
+    // Sumber dibaca sekali: hash-nya key cache, isinya di-decode kalau cache belum ada atau basi
+    vector<unsigned char> source;
+    if (!TextureCooker::ReadFile(path, source)) {
+        cerr << "Failed to read texture: " << path << endl;
+        return false;
+    }
+    uint64_t sourceHash = TextureCooker::HashBytes(source.data(), source.size());
+    string cachePath;
+    if (!cookedCacheDir.empty()) {
+        cachePath = TextureCooker::GetCachePath(cookedCacheDir, sourceHash, cookOptions);
+        auto mapped = make_unique<MappedFile>();
+        if (mapped->Open(cachePath) && TextureCooker::Parse(mapped->GetData(), mapped->GetSize(), sourceHash, image.cooked)) {
+            image.mapped = move(mapped);
+            image.fromCache = true;
+            return true;
+        }
+        image.cooked = CookedTexture();
+    }
+
+    // Flip per thread supaya orientasi tidak tergantung flag global yang diubah kode lain.
+    // Selalu RGBA supaya upload dan klasifikasi alpha tidak tergantung format file.
+    stbi_set_flip_vertically_on_load_thread(1);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = nullptr;
+    try {
+        data = stbi_load_from_memory(source.data(), int(source.size()), &width, &height, &channels, 4);
+    }
+    catch (const exception& e) {
+        cerr << "Exception loading texture: " << e.what() << endl;
+        return false;
+    }
+    if (!data) {
+        cerr << "Failed to load texture: " << path << " - " << stbi_failure_reason() << endl;
+        return false;
+    }
+
+    // Renderer memilih pass opaque/cutout/translucent dari alpha texture
+    SpriteAlphaMode alphaMode = ClassifyAlpha(data, size_t(width) * height, 4);
+    // Cook sekali, load berikutnya file ini di-map dan di-upload tanpa decode maupun glGenerateMipmap
+    image.cookedBlob = TextureCooker::Cook(data, width, height, alphaMode, sourceHash, cookOptions);
+    stbi_image_free(data);
+    TextureCooker::Parse(image.cookedBlob.data(), image.cookedBlob.size(), sourceHash, image.cooked);
+    if (!cachePath.empty() && !TextureCooker::WriteCacheFile(cachePath, image.cookedBlob)) {
+        cerr << "Failed to write cooked texture: " << cachePath << endl;
+    }
+    return true;
+}
+
+uint32_t ImageCache::ThumbnailLevel(const CookedTexture& cooked) {
+    uint32_t level = 0;
+    while (level + 1 < cooked.header->mipCount &&
+           max(cooked.levels[level].width, cooked.levels[level].height) > uint32_t(ThumbnailSize)) {
+        level++;
+    }
+    return level;
+}
+
+GLuint ImageCache::UploadLevels(GLuint texture, const CookedTexture& cooked, uint32_t firstLevel, bool thumbnail) const {
+    if (texture == 0) glGenTextures(1, &texture);
+    if (texture == 0) {
+        cerr << "Failed to generate texture ID" << endl;
+        return 0;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    // Sprite boleh memakai UV di luar 0..1, icon di-clamp supaya tepinya tidak mengambil sisi seberang
+    GLint wrap = thumbnail ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, GLint(cooked.header->mipCount - firstLevel) - 1);
+
+    // Semua level sudah ada di file, langsung dari mapping tanpa copy
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    CookedTextureFormat format = cooked.GetFormat();
+    for (uint32_t level = firstLevel; level < cooked.header->mipCount; level++) {
+        const CookedMipLevel& mip = cooked.levels[level];
+        GLint target = GLint(level - firstLevel);
+        if (format == CookedTextureFormat::RGBA8) {
+            glTexImage2D(GL_TEXTURE_2D, target, GL_RGBA, GLsizei(mip.width), GLsizei(mip.height), 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, cooked.GetLevelData(level));
+        } else {
+            GLenum internalFormat = format == CookedTextureFormat::BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            glCompressedTexImage2D(GL_TEXTURE_2D, target, internalFormat, GLsizei(mip.width), GLsizei(mip.height), 0,
+                                   GLsizei(mip.size), cooked.GetLevelData(level));
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+void ImageCache::Upload(Entry& entry, ImageVariant variant, const CookedTexture& cooked) {
+    entry.alphaMode = SpriteAlphaMode(cooked.header->alphaMode);
+    // Alias thumbnail dan preview ditentukan sekali saat texture pertama entry dibuat
+    if (!entry.full.texture && !entry.thumbnail.texture) {
+        entry.thumbnailIsFull = ThumbnailLevel(cooked) == 0;
+        UpdatePreview(entry, cooked);
+    }
+
+    Variant& target = Resolve(entry, variant);
+    bool thumbnail = &target == &entry.thumbnail;
+    uint32_t firstLevel = thumbnail ? ThumbnailLevel(cooked) : 0;
+    target.texture = UploadLevels(target.texture, cooked, firstLevel, thumbnail);
+    target.width = int(cooked.levels[firstLevel].width);
+    target.height = int(cooked.levels[firstLevel].height);
+    target.bytes = 0;
+    for (uint32_t level = firstLevel; level < cooked.header->mipCount; level++) target.bytes += cooked.levels[level].size;
+}
+
+void ImageCache::UpdatePreview(Entry& entry, const CookedTexture& cooked) {
+    // Level kecil di-decode sekali, UI tidak perlu membaca texture kembali dari GPU
+    uint32_t level = 0;
+    while (level + 1 < cooked.header->mipCount &&
+           max(cooked.levels[level].width, cooked.levels[level].height) > uint32_t(PreviewSize)) {
+        level++;
+    }
+    entry.preview.width = int(cooked.levels[level].width);
+    entry.preview.height = int(cooked.levels[level].height);
+    TextureCooker::DecodeLevel(cooked, level, entry.preview.pixels);
+}
+
+ImageView ImageCache::MakeView(const Entry& entry, const Variant& variant) const {
+    ImageView view;
+    view.texture = variant.texture;
+    view.width = variant.width;
+    view.height = variant.height;
+    view.alphaMode = entry.alphaMode;
+    view.bytes = variant.bytes;
+    return view;
+}
+
+ImageView ImageCache::Load(const string& path, ImageVariant variant, bool pin) {
+    string normalizedPath = NormalizePath(path);
+    Entry& entry = entries[normalizedPath];
+    Variant* target = &Resolve(entry, variant);
+    if (target->texture) {
+        stats.hits++;
+    } else {
+        if (entry.failed) return ImageView();
+        DecodedImage image;
+        if (!Decode(normalizedPath, image)) {
+            // Tidak dicoba lagi setiap frame, Replace atau Shutdown mereset
+            entry.failed = true;
+            return ImageView();
+        }
+        stats.decodes++;
+        Upload(entry, variant, image.cooked);
+        target = &Resolve(entry, variant);
+        UpdateStats();
+    }
+    if (pin) target->pinned = true;
+    else target->refs++;
+    return MakeView(entry, *target);
+}
+
+ImageView ImageCache::Get(const string& path, ImageVariant variant) {
+    return Load(path, variant, true);
+}
+
+ImageView ImageCache::Acquire(const string& path, ImageVariant variant) {
+    return Load(path, variant, false);
+}
+
+ImageView ImageCache::AcquireResident(const string& path) {
+    auto it = entries.find(NormalizePath(path));
+    if (it == entries.end() || !it->second.full.texture) return ImageView();
+    stats.hits++;
+    it->second.full.refs++;
+    return MakeView(it->second, it->second.full);
+}
+
+ImageView ImageCache::Insert(DecodedImage& image) {
+    string normalizedPath = NormalizePath(image.path);
+    Entry& entry = entries[normalizedPath];
+    if (!entry.full.texture) {
+        if (!image.IsValid()) return ImageView();
+        Upload(entry, ImageVariant::FULL, image.cooked);
+        entry.failed = false;
+        UpdateStats();
+    }
+    entry.full.refs++;
+    return MakeView(entry, entry.full);
+}
+
+void ImageCache::Free(Variant& variant) {
+    if (variant.texture) glDeleteTextures(1, &variant.texture);
+    variant = Variant();
+}
+
+bool ImageCache::Release(const string& path, ImageVariant variant) {
+    auto it = entries.find(NormalizePath(path));
+    if (it == entries.end()) return false;
+    Entry& entry = it->second;
+    Variant& target = Resolve(entry, variant);
+    if (target.refs > 0) target.refs--;
+    if (target.refs > 0 || target.pinned) return false;
+
+    Free(target);
+    if (!entry.full.texture && !entry.thumbnail.texture) entries.erase(it);
+    UpdateStats();
+    return true;
+}
+
+bool ImageCache::IsReleasable(const string& path, ImageVariant variant) const {
+    auto it = entries.find(NormalizePath(path));
+    if (it == entries.end()) return false;
+    const Entry& entry = it->second;
+    const Variant& target = variant == ImageVariant::THUMBNAIL && !entry.thumbnailIsFull ? entry.thumbnail : entry.full;
+    return target.texture != 0 && target.refs <= 1 && !target.pinned;
+}
+
+const ImagePreview* ImageCache::FindPreview(const string& path) const {
+    auto it = entries.find(NormalizePath(path));
+    if (it == entries.end() || it->second.preview.pixels.empty()) return nullptr;
+    return &it->second.preview;
+}
+
+void ImageCache::Replace(const string& path, int width, int height, const unsigned char* pixels) {
+    auto it = entries.find(NormalizePath(path));
+    if (it == entries.end()) return;
+    Entry& entry = it->second;
+
+    // Orientasi cache baris bawah dulu
+    size_t rowBytes = size_t(width) * 4;
+    vector<unsigned char> flipped(rowBytes * height);
+    for (int y = 0; y < height; y++) {
+        copy(pixels + rowBytes * y, pixels + rowBytes * (y + 1), flipped.begin() + rowBytes * (height - 1 - y));
+    }
+    SpriteAlphaMode alphaMode = ClassifyAlpha(flipped.data(), size_t(width) * height, 4);
+    // Tidak ditulis ke cache disk, file sumber baru akan punya hash baru saat di-load ulang
+    TextureCookOptions options;
+    vector<unsigned char> blob = TextureCooker::Cook(flipped.data(), width, height, alphaMode, 0, options);
+    CookedTexture cooked;
+    if (!TextureCooker::Parse(blob.data(), blob.size(), 0, cooked)) return;
+
+    // Variant yang sudah ada di-upload ulang ke nama texture yang sama, draw list ImGui frame ini tetap valid
+    entry.failed = false;
+    UpdatePreview(entry, cooked);
+    if (entry.full.texture) Upload(entry, ImageVariant::FULL, cooked);
+    if (entry.thumbnail.texture) Upload(entry, ImageVariant::THUMBNAIL, cooked);
+    UpdateStats();
+}
+
+void ImageCache::Shutdown() {
+    for (auto& [path, entry] : entries) {
+        Free(entry.full);
+        Free(entry.thumbnail);
+    }
+    entries.clear();
+    UpdateStats();
+}
+
+void ImageCache::UpdateStats() {
+    stats.entries = uint32_t(entries.size());
+    stats.textures = 0;
+    stats.bytes = 0;
+    for (const auto& [path, entry] : entries) {
+        for (const Variant* variant : { &entry.full, &entry.thumbnail }) {
+            if (!variant->texture) continue;
+            stats.textures++;
+            stats.bytes += variant->bytes;
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include <ObjectPicker.hpp>
+#include <algorithm>
+
+using namespace std;
+
+ObjectPicker::~ObjectPicker() {
+    Shutdown();
+}
+
+void ObjectPicker::Init() {
+    for (Slot& slot : slots) {
+        glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(GLuint), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void ObjectPicker::Shutdown() {
+    Reset();
+    for (Slot& slot : slots) {
+        if (slot.pbo) glDeleteBuffers(1, &slot.pbo);
+        slot.pbo = 0;
+    }
+}
+
+void ObjectPicker::Reset() {
+    queued.clear();
+    ready.clear();
+    for (Slot& slot : slots) {
+        if (slot.fence) glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        slot.queue = nullptr;
+    }
+}
+
+void ObjectPicker::Request(int x, int y, PickPurpose purpose) {
+    if (purpose == PickPurpose::HOVER) {
+        for (PickResult& request : queued) {
+            if (request.purpose != PickPurpose::HOVER) continue;
+            request.x = x;
+            request.y = y;
+            return;
+        }
+    }
+    PickResult request;
+    request.purpose = purpose;
+    request.x = x;
+    request.y = y;
+    queued.push_back(request);
+}
+
+void ObjectPicker::Issue(GLuint framebuffer, int width, int height, const RenderQueue& queue) {
+    if (queued.empty() || !framebuffer) return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+
+    size_t consumed = 0;
+    for (Slot& slot : slots) {
+        if (consumed == queued.size()) break;
+        if (slot.fence || !slot.pbo) continue;
+
+        PickResult& request = queued[consumed++];
+        // Di luar viewport langsung kosong tanpa read
+        if (request.x < 0 || request.y < 0 || request.x >= width || request.y >= height) {
+            ready.push_back(request);
+            continue;
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glReadPixels(request.x, request.y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.request = request;
+        slot.queue = &queue;
+    }
+    queued.erase(queued.begin(), queued.begin() + consumed);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+void ObjectPicker::PreserveOrder(const RenderQueue& queue) {
+    for (Slot& slot : slots) {
+        if (!slot.fence || slot.queue != &queue) continue;
+        slot.order.resize(queue.Size());
+        for (size_t i = 0; i < slot.order.size(); i++) slot.order[i] = queue.IndexAt(i);
+        slot.queue = nullptr;
+    }
+}
+
+void ObjectPicker::Poll(const RenderQueue& queue, vector<PickResult>& results) {
+    results.insert(results.end(), ready.begin(), ready.end());
+    ready.clear();
+
+    for (Slot& slot : slots) {
+        if (!slot.fence) continue;
+        GLenum status = glClientWaitSync(slot.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        GLuint id = 0;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, sizeof(GLuint), &id);
+
+        // ID = posisi di antrian + 1, urutan antrian diambil dari saat ID ditulis
+        PickResult result = slot.request;
+        result.objectIndex = -1;
+        if (id > 0) {
+            size_t position = id - 1;
+            if (slot.queue == &queue && position < queue.Size()) result.objectIndex = int(queue.IndexAt(position));
+            else if (!slot.queue && position < slot.order.size()) result.objectIndex = int(slot.order[position]);
+        }
+        slot.queue = nullptr;
+        results.push_back(result);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
@@ -0,0 +1,391 @@
+#include <ParticleSystem.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_SYSTEM_SSE2 1
+#endif
+
+using namespace std;
+
+namespace {
+    // xorshift32, cukup untuk variasi partikel dan jauh lebih murah dari <random>
+    inline float NextRandom(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return float(state >> 8) * (1.0f / 16777216.0f);
+    }
+
+    inline uint32_t PackColor(float r, float g, float b, float a) {
+        auto channel = [](float value) {
+            return uint32_t(min(max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+        };
+        return channel(r) | (channel(g) << 8) | (channel(b) << 16) | (channel(a) << 24);
+    }
+}
+
+void ParticleSystem::Pool::Reserve(size_t newCapacity) {
+    newCapacity = (newCapacity + 3) & ~size_t(3);
+    std::vector<float>* arrays[] = { &posX, &posY, &velX, &velY, &age, &ageRate, &size, &r, &g, &b, &a };
+    for (std::vector<float>* array : arrays) array->resize(newCapacity, 0.0f);
+    capacity = newCapacity;
+    count = min(count, capacity);
+}
+
+void ParticleSystem::Pool::Kill(size_t index) {
+    // Swap dengan partikel hidup terakhir, urutan partikel tidak penting
+    size_t last = --count;
+    posX[index] = posX[last];
+    posY[index] = posY[last];
+    velX[index] = velX[last];
+    velY[index] = velY[last];
+    age[index] = age[last];
+    ageRate[index] = ageRate[last];
+    size[index] = size[last];
+    r[index] = r[last];
+    g[index] = g[last];
+    b[index] = b[last];
+    a[index] = a[last];
+}
+
+ParticleSystem::~ParticleSystem() {
+    Shutdown();
+}
+
+void ParticleSystem::Init(GLStateCache& stateCache, StreamBuffer& streamBuffer) {
+    state = &stateCache;
+    stream = &streamBuffer;
+    // Unit quad (0..1), pusat dan ukuran datang dari instance
+    float corners[] = {
+        0.0f, 0.0f, // bottom left
+        1.0f, 0.0f, // bottom right
+        1.0f, 1.0f, // top right
+        0.0f, 1.0f  // top left
+    };
+    GLuint indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &quadVBO);
+    glGenBuffers(1, &quadEBO);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    // Atribut per-instance: posisi + size (1), warna (2), pointer diatur per run
+    for (GLuint attrib = 1; attrib <= 2; attrib++) {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+
+    glBindVertexArray(0);
+}
+
+void ParticleSystem::Shutdown() {
+    Clear();
+    if (quadEBO) { glDeleteBuffers(1, &quadEBO); quadEBO = 0; }
+    if (quadVBO) { glDeleteBuffers(1, &quadVBO); quadVBO = 0; }
+    if (vao) {
+        if (state) state->ForgetVertexArray(vao);
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+}
+
+void ParticleSystem::Clear() {
+    pools.clear();
+    stats.liveParticles = 0;
+}
+
+size_t ParticleSystem::GetLiveCount() const {
+    size_t live = 0;
+    for (const Pool& pool : pools) live += pool.count;
+    return live;
+}
+
+void ParticleSystem::Integrate(Pool& pool, const ParticleEmitter& emitter, float dt, size_t begin, size_t end) {
+    float damping = max(0.0f, 1.0f - emitter.drag * dt);
+    float sizeDelta = emitter.endSize - emitter.startSize;
+    const float* c0 = emitter.startColor;
+    const float* c1 = emitter.endColor;
+    size_t i = begin;
+
+#ifdef PARTICLE_SYSTEM_SSE2
+    // begin dan end kelipatan 4 (kapasitas pool juga), 4 partikel per iterasi
+    const __m128 vDt = _mm_set1_ps(dt);
+    const __m128 vDamping = _mm_set1_ps(damping);
+    const __m128 vGravityX = _mm_set1_ps(emitter.gravityX * dt);
+    const __m128 vGravityY = _mm_set1_ps(emitter.gravityY * dt);
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    const __m128 vSize0 = _mm_set1_ps(emitter.startSize), vSizeDelta = _mm_set1_ps(sizeDelta);
+    const __m128 vR0 = _mm_set1_ps(c0[0]), vRDelta = _mm_set1_ps(c1[0] - c0[0]);
+    const __m128 vG0 = _mm_set1_ps(c0[1]), vGDelta = _mm_set1_ps(c1[1] - c0[1]);
+    const __m128 vB0 = _mm_set1_ps(c0[2]), vBDelta = _mm_set1_ps(c1[2] - c0[2]);
+    const __m128 vA0 = _mm_set1_ps(c0[3]), vADelta = _mm_set1_ps(c1[3] - c0[3]);
+    float* posX = pool.posX.data();
+    float* posY = pool.posY.data();
+    float* velX = pool.velX.data();
+    float* velY = pool.velY.data();
+    float* age = pool.age.data();
+    const float* ageRate = pool.ageRate.data();
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(velX + i), vDamping), vGravityX);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(velY + i), vDamping), vGravityY);
+        _mm_storeu_ps(velX + i, vx);
+        _mm_storeu_ps(velY + i, vy);
+        _mm_storeu_ps(posX + i, _mm_add_ps(_mm_loadu_ps(posX + i), _mm_mul_ps(vx, vDt)));
+        _mm_storeu_ps(posY + i, _mm_add_ps(_mm_loadu_ps(posY + i), _mm_mul_ps(vy, vDt)));
+
+        __m128 vAge = _mm_add_ps(_mm_loadu_ps(age + i), _mm_mul_ps(_mm_loadu_ps(ageRate + i), vDt));
+        _mm_storeu_ps(age + i, vAge);
+        __m128 t = _mm_min_ps(vAge, vOne);
+
+        _mm_storeu_ps(pool.size.data() + i, _mm_add_ps(vSize0, _mm_mul_ps(vSizeDelta, t)));
+        _mm_storeu_ps(pool.r.data() + i, _mm_add_ps(vR0, _mm_mul_ps(vRDelta, t)));
+        _mm_storeu_ps(pool.g.data() + i, _mm_add_ps(vG0, _mm_mul_ps(vGDelta, t)));
+        _mm_storeu_ps(pool.b.data() + i, _mm_add_ps(vB0, _mm_mul_ps(vBDelta, t)));
+        _mm_storeu_ps(pool.a.data() + i, _mm_add_ps(vA0, _mm_mul_ps(vADelta, t)));
+    }
+#endif
+
+    for (; i < end; i++) {
+        pool.velX[i] = pool.velX[i] * damping + emitter.gravityX * dt;
+        pool.velY[i] = pool.velY[i] * damping + emitter.gravityY * dt;
+        pool.posX[i] += pool.velX[i] * dt;
+        pool.posY[i] += pool.velY[i] * dt;
+        pool.age[i] += pool.ageRate[i] * dt;
+        float t = min(pool.age[i], 1.0f);
+        pool.size[i] = emitter.startSize + sizeDelta * t;
+        pool.r[i] = c0[0] + (c1[0] - c0[0]) * t;
+        pool.g[i] = c0[1] + (c1[1] - c0[1]) * t;
+        pool.b[i] = c0[2] + (c1[2] - c0[2]) * t;
+        pool.a[i] = c0[3] + (c1[3] - c0[3]) * t;
+    }
+}
+
+void ParticleSystem::RemoveDead(Pool& pool, uint32_t& died) {
+    for (size_t i = 0; i < pool.count;) {
+        if (pool.age[i] >= 1.0f) {
+            pool.Kill(i);
+            died++;
+        } else {
+            i++;
+        }
+    }
+}
+
+void ParticleSystem::Spawn(Pool& pool, const ParticleEmitter& emitter, float dt, uint32_t& spawned) {
+    if (!emitter.emitting || emitter.rate <= 0.0f) {
+        pool.spawnAccumulator = 0.0f;
+        return;
+    }
+
+    pool.spawnAccumulator += emitter.rate * dt;
+    size_t wanted = static_cast<size_t>(pool.spawnAccumulator);
+    pool.spawnAccumulator -= float(wanted);
+    size_t limit = min<size_t>(emitter.maxParticles, pool.capacity);
+    size_t room = limit > pool.count ? limit - pool.count : 0;
+    size_t n = min(wanted, room);
+
+    const float degToRad = 3.14159265f / 180.0f;
+    float lifetimeMin = max(emitter.lifetimeMin, 0.001f);
+    float lifetimeMax = max(emitter.lifetimeMax, lifetimeMin);
+    for (size_t k = 0; k < n; k++) {
+        size_t i = pool.count++;
+        float angle = (emitter.direction + (NextRandom(pool.random) * 2.0f - 1.0f) * emitter.spread) * degToRad;
+        float speed = emitter.speedMin + (emitter.speedMax - emitter.speedMin) * NextRandom(pool.random);
+        float lifetime = lifetimeMin + (lifetimeMax - lifetimeMin) * NextRandom(pool.random);
+        pool.posX[i] = emitter.x;
+        pool.posY[i] = emitter.y;
+        pool.velX[i] = cos(angle) * speed;
+        pool.velY[i] = sin(angle) * speed;
+        pool.age[i] = 0.0f;
+        pool.ageRate[i] = 1.0f / lifetime;
+        pool.size[i] = emitter.startSize;
+        pool.r[i] = emitter.startColor[0];
+        pool.g[i] = emitter.startColor[1];
+        pool.b[i] = emitter.startColor[2];
+        pool.a[i] = emitter.startColor[3];
+    }
+    spawned += static_cast<uint32_t>(n);
+}
+
+bool ParticleSystem::Update(const Scene& scene, float dt, WorkerPool* workers) {
+    auto start = chrono::steady_clock::now();
+    dt = min(max(dt, 0.0f), MaxStep);
+    stats.spawned = stats.died = 0;
+    stats.threads = workers ? workers->GetThreadCount() : 1;
+
+    pools.resize(scene.emitters.size());
+    bool active = false;
+    for (size_t e = 0; e < scene.emitters.size(); e++) {
+        const ParticleEmitter& emitter = scene.emitters[e];
+        Pool& pool = pools[e];
+        // Emitter baru atau index dipakai emitter lain: mulai dari kosong
+        if (pool.id != emitter.id) {
+            pool = Pool();
+            pool.id = emitter.id;
+            pool.random ^= static_cast<uint32_t>(emitter.id * 2654435761u);
+            if (pool.random == 0) pool.random = 1;
+        }
+        size_t wantedCapacity = (size_t(emitter.maxParticles) + 3) & ~size_t(3);
+        if (pool.capacity != wantedCapacity) pool.Reserve(wantedCapacity);
+
+        if (pool.count > 0 && dt > 0.0f) {
+            // Blok terakhir diproses penuh 4 partikel, slot di belakang count tidak dipakai
+            size_t padded = (pool.count + 3) & ~size_t(3);
+            if (workers) {
+                workers->ParallelFor(padded, MinUpdateChunk, [&](size_t, size_t begin, size_t end) {
+                    Integrate(pool, emitter, dt, begin, end);
+                }, 4);
+            } else {
+                Integrate(pool, emitter, dt, 0, padded);
+            }
+            RemoveDead(pool, stats.died);
+        }
+        Spawn(pool, emitter, dt, stats.spawned);
+
+        active |= pool.count > 0 || (emitter.emitting && emitter.rate > 0.0f);
+    }
+
+    stats.emitters = static_cast<uint32_t>(scene.emitters.size());
+    stats.liveParticles = static_cast<uint32_t>(GetLiveCount());
+    stats.updateMs = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+    return active;
+}
+
+void ParticleSystem::WriteInstances(const Pool& pool, ParticleInstance* out, size_t begin, size_t end) {
+    size_t i = begin;
+
+#ifdef PARTICLE_SYSTEM_SSE2
+    // Warna dipack ke RGBA8 lalu SoA -> AoS dengan transpose 4x4, satu store per instance
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vOne = _mm_set1_ps(1.0f);
+    const __m128 vScale = _mm_set1_ps(255.0f);
+    auto channel = [&](const float* values) {
+        __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(values), vZero), vOne);
+        return _mm_cvtps_epi32(_mm_mul_ps(clamped, vScale));
+    };
+    for (; i + 4 <= end; i += 4) {
+        __m128i color = _mm_or_si128(
+            _mm_or_si128(channel(pool.r.data() + i), _mm_slli_epi32(channel(pool.g.data() + i), 8)),
+            _mm_or_si128(_mm_slli_epi32(channel(pool.b.data() + i), 16), _mm_slli_epi32(channel(pool.a.data() + i), 24)));
+        __m128 x = _mm_loadu_ps(pool.posX.data() + i);
+        __m128 y = _mm_loadu_ps(pool.posY.data() + i);
+        __m128 size = _mm_loadu_ps(pool.size.data() + i);
+        __m128 packed = _mm_castsi128_ps(color);
+        _MM_TRANSPOSE4_PS(x, y, size, packed);
+        _mm_storeu_ps(reinterpret_cast<float*>(out + i), x);
+        _mm_storeu_ps(reinterpret_cast<float*>(out + i + 1), y);
+        _mm_storeu_ps(reinterpret_cast<float*>(out + i + 2), size);
+        _mm_storeu_ps(reinterpret_cast<float*>(out + i + 3), packed);
+    }
+#endif
+
+    for (; i < end; i++) {
+        ParticleInstance& instance = out[i];
+        instance.x = pool.posX[i];
+        instance.y = pool.posY[i];
+        instance.size = pool.size[i];
+        instance.color = PackColor(pool.r[i], pool.g[i], pool.b[i], pool.a[i]);
+    }
+}
+
+void ParticleSystem::SetInstanceAttributes(GLintptr baseOffset, uint32_t firstInstance) {
+    // Tanpa base instance (GL 4.2), offset run diatur lewat pointer atribut
+    size_t base = baseOffset + firstInstance * sizeof(ParticleInstance);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)(base + offsetof(ParticleInstance, x)));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ParticleInstance), (void*)(base + offsetof(ParticleInstance, color)));
+}
+
+void ParticleSystem::Render(const Scene& scene, ShaderProgram& program, TextureManager& textures,
+                            GLuint fallbackTexture, bool overdraw, WorkerPool* workers) {
+    auto start = chrono::steady_clock::now();
+    stats.drawCalls = 0;
+    runs.clear();
+
+    size_t emitterCount = min(scene.emitters.size(), pools.size());
+    drawOrder.clear();
+    for (uint32_t e = 0; e < emitterCount; e++) {
+        if (pools[e].count > 0 && pools[e].id == scene.emitters[e].id) drawOrder.push_back(e);
+    }
+    if (drawOrder.empty()) {
+        stats.writeMs = 0.0f;
+        return;
+    }
+    stable_sort(drawOrder.begin(), drawOrder.end(), [&](uint32_t a, uint32_t b) {
+        const ParticleEmitter& emitterA = scene.emitters[a];
+        const ParticleEmitter& emitterB = scene.emitters[b];
+        if (emitterA.layer != emitterB.layer) return emitterA.layer < emitterB.layer;
+        return emitterA.depth < emitterB.depth;
+    });
+
+    // Emitter berurutan dengan texture dan blend yang sama digabung jadi satu run
+    size_t total = 0;
+    drawOffsets.resize(drawOrder.size());
+    for (size_t d = 0; d < drawOrder.size(); d++) {
+        const ParticleEmitter& emitter = scene.emitters[drawOrder[d]];
+        GLuint texture = emitter.texturePath.empty() ? 0 : textures.RequestTexture(emitter.texturePath);
+        if (texture == 0) texture = fallbackTexture;
+
+        uint32_t count = static_cast<uint32_t>(pools[drawOrder[d]].count);
+        if (runs.empty() || runs.back().texture != texture || runs.back().additive != emitter.additive) {
+            runs.push_back({ texture, emitter.additive, static_cast<uint32_t>(total), 0 });
+        }
+        runs.back().count += count;
+        drawOffsets[d] = total;
+        total += count;
+    }
+
+    // Satu allocation untuk semua partikel frame ini
+    StreamAllocation allocation;
+    if (stream->Reserve(total * sizeof(ParticleInstance), sizeof(ParticleInstance))) {
+        allocation = stream->Allocate(total * sizeof(ParticleInstance), sizeof(ParticleInstance));
+    }
+    if (!allocation.IsValid()) {
+        stats.writeMs = 0.0f;
+        return;
+    }
+    ParticleInstance* out = static_cast<ParticleInstance*>(allocation.data);
+    for (size_t d = 0; d < drawOrder.size(); d++) {
+        const Pool& pool = pools[drawOrder[d]];
+        ParticleInstance* emitterOut = out + drawOffsets[d];
+        if (workers) {
+            workers->ParallelFor(pool.count, MinUpdateChunk, [&](size_t, size_t begin, size_t end) {
+                WriteInstances(pool, emitterOut, begin, end);
+            }, 4);
+        } else {
+            WriteInstances(pool, emitterOut, 0, pool.count);
+        }
+    }
+    stream->Flush();
+    stats.writeMs = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+
+    program.Use(*state);
+    program.SetInt("u_Texture", 0);
+    if (overdraw) program.SetFloat("u_AlphaCutoff", 0.01f);
+
+    state->BindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->GetBuffer());
+    for (const ParticleRun& run : runs) {
+        if (overdraw) state->SetBlendFunc(GL_ONE, GL_ONE);
+        else if (run.additive) state->SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        else state->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        SetInstanceAttributes(allocation.offset, run.first);
+        state->BindTexture(0, run.texture);
+        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, run.count);
+        stats.drawCalls++;
+    }
+    state->SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
@@ -0,0 +1,113 @@
+#include <ReadbackService.hpp>
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+ReadbackService::~ReadbackService() {
+    Shutdown();
+}
+
+void ReadbackService::Init() {
+    for (Slot& slot : slots) glGenBuffers(1, &slot.pbo);
+}
+
+void ReadbackService::Shutdown() {
+    Cancel();
+    for (Slot& slot : slots) {
+        if (slot.pbo) glDeleteBuffers(1, &slot.pbo);
+        slot = Slot();
+    }
+}
+
+void ReadbackService::Cancel() {
+    for (Slot& slot : slots) {
+        if (slot.fence) glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        slot.callback = nullptr;
+    }
+    stats.inFlight = 0;
+}
+
+bool ReadbackService::HasFreeSlot() const {
+    for (const Slot& slot : slots) {
+        if (!slot.fence && slot.pbo) return true;
+    }
+    return false;
+}
+
+bool ReadbackService::Request(GLuint framebuffer, int x, int y, int width, int height, ReadbackCallback callback) {
+    stats.requests++;
+    if (!framebuffer || width <= 0 || height <= 0) return false;
+
+    Slot* slot = nullptr;
+    for (Slot& candidate : slots) {
+        if (!candidate.fence && candidate.pbo) { slot = &candidate; break; }
+    }
+    if (!slot) {
+        stats.rejected++;
+        return false;
+    }
+
+    size_t bytes = size_t(width) * height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    if (slot->capacity < bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+        slot->capacity = bytes;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->width = width;
+    slot->height = height;
+    slot->requestPoll = pollCount;
+    slot->callback = move(callback);
+    stats.inFlight++;
+
+    // Binding dikembalikan ke 0, sama dengan state akhir RenderSceneToTexture
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    return true;
+}
+
+void ReadbackService::Poll(bool wait) {
+    pollCount++;
+    for (Slot& slot : slots) {
+        if (!slot.fence) continue;
+        GLenum status = wait ? glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull)
+                             : glClientWaitSync(slot.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        stats.inFlight--;
+
+        ReadbackImage image;
+        image.width = slot.width;
+        image.height = slot.height;
+        image.pixels.resize(size_t(slot.width) * slot.height * 4);
+
+        // GL menyimpan baris bawah dulu, dibalik saat disalin keluar dari buffer
+        size_t stride = size_t(slot.width) * 4;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        const unsigned char* mapped = static_cast<const unsigned char*>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, stride * slot.height, GL_MAP_READ_BIT));
+        if (mapped) {
+            for (int row = 0; row < slot.height; row++) {
+                memcpy(&image.pixels[size_t(row) * stride], mapped + size_t(slot.height - 1 - row) * stride, stride);
+            }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        stats.completed++;
+        stats.lastLatency = static_cast<uint32_t>(pollCount - slot.requestPoll);
+        stats.bytesRead += stride * slot.height;
+
+        // Slot sudah bebas sebelum callback, callback boleh langsung request lagi
+        ReadbackCallback callback = move(slot.callback);
+        slot.callback = nullptr;
+        if (mapped && callback) callback(image);
+    }
+}
@@ -0,0 +1,179 @@
+#include <RenderProfiler.hpp>
+#include <imgui.h>
+#include <json.hpp>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+using json = nlohmann::json;
+
+static float ElapsedMs(chrono::steady_clock::time_point start) {
+    return chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+}
+
+RenderProfiler::~RenderProfiler() {
+    Shutdown();
+}
+
+void RenderProfiler::Init() {
+    if (initialized) return;
+    for (Slot& slot : slots) {
+        glGenQueries(PassCount, slot.queries);
+    }
+    initialized = true;
+}
+
+void RenderProfiler::Shutdown() {
+    if (!initialized) return;
+    for (Slot& slot : slots) {
+        glDeleteQueries(PassCount, slot.queries);
+        for (int i = 0; i < PassCount; i++) {
+            slot.queries[i] = 0;
+            slot.issued[i] = false;
+        }
+    }
+    initialized = false;
+}
+
+const char* RenderProfiler::PassName(RenderPass pass) {
+    switch (pass) {
+        case RenderPass::GRID: return "grid";
+        case RenderPass::TILES: return "tiles";
+        case RenderPass::SPRITES: return "sprites";
+        case RenderPass::PARTICLES: return "particles";
+        case RenderPass::GIZMO: return "gizmo";
+        default: return "unknown";
+    }
+}
+
+void RenderProfiler::Collect(Slot& slot) {
+    bool any = false;
+    float gpuTotal = 0.0f;
+    for (int i = 0; i < PassCount; i++) {
+        if (!slot.issued[i]) continue;
+
+        // Setelah QueryLatency frame hasilnya hampir selalu siap; kalau belum, baca saja (menunggu)
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(slot.queries[i], GL_QUERY_RESULT, &elapsed);
+        slot.issued[i] = false;
+
+        slot.stats.passes[i].gpuMs = elapsed / 1000000.0f;
+        gpuTotal += slot.stats.passes[i].gpuMs;
+        any = true;
+    }
+    if (!any) return;
+
+    slot.stats.gpuMs = gpuTotal;
+    completed = slot.stats;
+}
+
+void RenderProfiler::BeginFrame(const GLStateStats& state) {
+    if (!initialized) return;
+
+    current = (current + 1) % QueryLatency;
+    Slot& slot = slots[current];
+
+    // Slot ini dipakai QueryLatency frame yang lalu, hasil GPU-nya dibaca sebelum query dipakai ulang
+    Collect(slot);
+
+    slot.stats = RenderFrameStats();
+    slot.stats.frame = ++frameCounter;
+    frameStart = chrono::steady_clock::now();
+    passStartState = state;
+}
+
+void RenderProfiler::EndFrame() {
+    if (!initialized) return;
+    slots[current].stats.cpuMs = ElapsedMs(frameStart);
+}
+
+void RenderProfiler::BeginPass(RenderPass pass, const GLStateStats& state) {
+    if (!initialized || passActive) return;
+
+    // GL_TIME_ELAPSED tidak bisa bersarang, pass dijalankan berurutan
+    Slot& slot = slots[current];
+    glBeginQuery(GL_TIME_ELAPSED, slot.queries[(int)pass]);
+    slot.issued[(int)pass] = true;
+
+    passActive = true;
+    passStartState = state;
+    passStart = chrono::steady_clock::now();
+}
+
+void RenderProfiler::EndPass(RenderPass pass, const GLStateStats& state) {
+    if (!initialized || !passActive) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    passActive = false;
+
+    RenderPassStats& stats = slots[current].stats.passes[(int)pass];
+    stats.cpuMs = ElapsedMs(passStart);
+    stats.stateChanges = state.issued - passStartState.issued;
+    stats.textureBinds = state.textureBinds - passStartState.textureBinds;
+}
+
+void RenderProfiler::AddDraws(RenderPass pass, uint32_t drawCalls, uint32_t vertices) {
+    if (!initialized) return;
+    RenderPassStats& stats = slots[current].stats.passes[(int)pass];
+    stats.drawCalls += drawCalls;
+    stats.vertices += vertices;
+}
+
+void RenderProfiler::DrawOverlay() const {
+    const RenderFrameStats& stats = completed;
+    ImGui::Text("Frame %llu  CPU %.3f ms  GPU %.3f ms", (unsigned long long)stats.frame, stats.cpuMs, stats.gpuMs);
+    if (ImGui::BeginTable("##RenderPasses", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("CPU ms");
+        ImGui::TableSetupColumn("GPU ms");
+        ImGui::TableSetupColumn("Draws");
+        ImGui::TableSetupColumn("Vertices");
+        ImGui::TableSetupColumn("Tex Binds");
+        ImGui::TableSetupColumn("State");
+        ImGui::TableHeadersRow();
+        for (int i = 0; i < PassCount; i++) {
+            const RenderPassStats& pass = stats.passes[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(PassName((RenderPass)i));
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", pass.cpuMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", pass.gpuMs);
+            ImGui::TableNextColumn(); ImGui::Text("%u", pass.drawCalls);
+            ImGui::TableNextColumn(); ImGui::Text("%u", pass.vertices);
+            ImGui::TableNextColumn(); ImGui::Text("%u", pass.textureBinds);
+            ImGui::TableNextColumn(); ImGui::Text("%u", pass.stateChanges);
+        }
+        ImGui::EndTable();
+    }
+}
+
+string RenderProfiler::ToJson() const {
+    const RenderFrameStats& stats = completed;
+    json j;
+    j["frame"] = stats.frame;
+    j["cpuMs"] = stats.cpuMs;
+    j["gpuMs"] = stats.gpuMs;
+    j["passes"] = json::array();
+    for (int i = 0; i < PassCount; i++) {
+        const RenderPassStats& pass = stats.passes[i];
+        j["passes"].push_back({
+            {"name", PassName((RenderPass)i)},
+            {"cpuMs", pass.cpuMs},
+            {"gpuMs", pass.gpuMs},
+            {"drawCalls", pass.drawCalls},
+            {"vertices", pass.vertices},
+            {"textureBinds", pass.textureBinds},
+            {"stateChanges", pass.stateChanges}
+        });
+    }
+    return j.dump(4);
+}
+
+bool RenderProfiler::DumpToFile(const string& path) const {
+    ofstream out(path);
+    if (!out.is_open()) {
+        cerr << "Error: Could not open file for writing: " << path << endl;
+        return false;
+    }
+    out << ToJson();
+    return true;
+}
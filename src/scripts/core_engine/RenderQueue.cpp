@@ -0,0 +1,156 @@
+#include <RenderQueue.hpp>
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+static bool ItemLess(uint64_t keyA, uint32_t indexA, uint64_t keyB, uint32_t indexB) {
+    return keyA < keyB || (keyA == keyB && indexA < indexB);
+}
+
+uint64_t RenderQueue::MakeKey(int layer, float depth, uint32_t blend, uint32_t shader, uint32_t texture) {
+    // Layer -128..127 digeser jadi 0..255
+    uint64_t layerBits = static_cast<uint64_t>(min(max(layer, -128), 127) + 128);
+
+    // Depth -1024..1024 dikuantisasi ke 16 bit
+    const float depthRange = 1024.0f;
+    float normalized = (min(max(depth, -depthRange), depthRange) + depthRange) / (depthRange * 2.0f);
+    uint64_t depthBits = static_cast<uint64_t>(normalized * 65535.0f + 0.5f);
+
+    return (layerBits << 56) |
+           (depthBits << 40) |
+           (static_cast<uint64_t>(blend & 0xF) << 36) |
+           (static_cast<uint64_t>(shader & 0xFF) << 28) |
+           static_cast<uint64_t>(texture & 0xFFFFFFF);
+}
+
+void RenderQueue::Begin(size_t count) {
+    frame++;
+    objectCount = count;
+    items.clear();
+    changed.clear();
+    retained = keyChanged = 0;
+
+    if (currentKey.size() < count) {
+        currentKey.resize(count, 0);
+        pushFrame.resize(count, 0);
+        sortedGeneration.resize(count, 0);
+        sortedKey.resize(count, 0);
+    }
+}
+
+void RenderQueue::Push(uint32_t index, uint64_t key) {
+    Item item = { key, index };
+    items.push_back(item);
+    currentKey[index] = key;
+    pushFrame[index] = frame;
+
+    // Perubahan dicatat saat push supaya scene statis tidak perlu lintasan tambahan
+    if (sortedGeneration[index] == generation) {
+        retained++;
+        if (sortedKey[index] != key) {
+            keyChanged++;
+            changed.push_back(item);
+        }
+    } else {
+        changed.push_back(item);
+    }
+}
+
+void RenderQueue::Sort() {
+    auto start = chrono::steady_clock::now();
+    stats = RenderQueueStats();
+    stats.items = static_cast<uint32_t>(items.size());
+
+    // Jumlah object berubah berarti index bergeser, urutan lama tidak bisa dipakai
+    bool reused = objectCount == lastObjectCount && generation != 0 && IncrementalSort();
+    if (!reused) {
+        RadixSort();
+        stats.fullSort = true;
+        stats.changed = stats.items;
+
+        generation++;
+        for (const Item& item : sorted) {
+            sortedGeneration[item.index] = generation;
+            sortedKey[item.index] = item.key;
+        }
+    }
+    lastObjectCount = objectCount;
+
+    stats.sortMs = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+}
+
+bool RenderQueue::IncrementalSort() {
+    size_t removed = sorted.size() - retained;
+    size_t changedCount = changed.size() + removed;
+    // Terlalu banyak perubahan, radix penuh lebih murah daripada sort + merge
+    if (changedCount > items.size() / 4) return false;
+
+    stats.changed = static_cast<uint32_t>(changedCount);
+    if (changedCount == 0) return true;
+
+    // Buang item lama yang sudah tidak di-push atau key-nya berubah, urutan sisanya tetap benar
+    if (removed > 0 || keyChanged > 0) {
+        sorted.erase(remove_if(sorted.begin(), sorted.end(), [this](const Item& item) {
+            if (pushFrame[item.index] != frame) {
+                sortedGeneration[item.index] = 0;
+                return true;
+            }
+            return currentKey[item.index] != item.key;
+        }), sorted.end());
+    }
+
+    sort(changed.begin(), changed.end(), [](const Item& a, const Item& b) {
+        return ItemLess(a.key, a.index, b.key, b.index);
+    });
+    for (const Item& item : changed) {
+        sortedGeneration[item.index] = generation;
+        sortedKey[item.index] = item.key;
+    }
+
+    scratch.resize(sorted.size() + changed.size());
+    merge(sorted.begin(), sorted.end(), changed.begin(), changed.end(), scratch.begin(),
+          [](const Item& a, const Item& b) { return ItemLess(a.key, a.index, b.key, b.index); });
+    sorted.swap(scratch);
+    return true;
+}
+
+void RenderQueue::RadixSort() {
+    size_t count = items.size();
+    sorted = items;
+    scratch.resize(count);
+    if (count < 2) return;
+
+    // Histogram semua byte sekaligus dalam satu lintasan
+    uint32_t histogram[8][256] = {};
+    for (const Item& item : sorted) {
+        for (int pass = 0; pass < 8; pass++) {
+            histogram[pass][(item.key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    // LSD radix stabil, item di-push dengan index naik jadi hasilnya urut (key, index)
+    Item* src = sorted.data();
+    Item* dst = scratch.data();
+    for (int pass = 0; pass < 8; pass++) {
+        uint32_t* counts = histogram[pass];
+        int shift = pass * 8;
+
+        // Semua key punya byte yang sama di posisi ini, pass tidak mengubah urutan
+        if (counts[(src[0].key >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            uint32_t c = counts[bucket];
+            counts[bucket] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < count; i++) {
+            dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        swap(src, dst);
+        stats.radixPasses++;
+    }
+
+    if (src != sorted.data()) sorted.swap(scratch);
+}
@@ -0,0 +1,165 @@
+#include <RenderTargetPool.hpp>
+#include <iostream>
+#include <algorithm>
+#include <Debugger.hpp>
+
+using namespace std;
+
+RenderTargetPool& RenderTargetPool::Shared() {
+    static RenderTargetPool pool;
+    return pool;
+}
+
+int RenderTargetPool::BucketSize(int size) {
+    size = max(size, 1);
+    return ((size + BucketStep - 1) / BucketStep) * BucketStep;
+}
+
+RenderTarget* RenderTargetPool::Acquire(int width, int height) {
+    if (width <= 0 || height <= 0) return nullptr;
+
+    // Pilih target bebas dengan luas terkecil supaya target besar tetap tersedia
+    RenderTarget* best = nullptr;
+    for (auto& target : targets) {
+        if (target->inUse || !target->Fits(width, height)) continue;
+        if (!best || target->allocatedWidth * target->allocatedHeight < best->allocatedWidth * best->allocatedHeight) {
+            best = target.get();
+        }
+    }
+    if (best) {
+        best->inUse = true;
+        best->lastUsedFrame = frame;
+        stats.reuses++;
+        return best;
+    }
+
+    auto target = make_unique<RenderTarget>();
+    if (!Create(*target, BucketSize(width), BucketSize(height))) {
+        Destroy(*target);
+        return nullptr;
+    }
+    target->inUse = true;
+    target->lastUsedFrame = frame;
+    targets.push_back(move(target));
+    return targets.back().get();
+}
+
+void RenderTargetPool::Release(RenderTarget* target) {
+    if (!target) return;
+    target->inUse = false;
+    target->lastUsedFrame = frame;
+}
+
+void RenderTargetPool::Trim() {
+    for (auto& target : targets) {
+        if (!target->inUse) Destroy(*target);
+    }
+    targets.erase(remove_if(targets.begin(), targets.end(), [](const unique_ptr<RenderTarget>& target) {
+        return target->framebuffer == 0;
+    }), targets.end());
+}
+
+void RenderTargetPool::EndFrame() {
+    frame++;
+    size_t before = targets.size();
+    for (auto& target : targets) {
+        if (!target->inUse && frame - target->lastUsedFrame > MaxIdleFrames) Destroy(*target);
+    }
+    targets.erase(remove_if(targets.begin(), targets.end(), [](const unique_ptr<RenderTarget>& target) {
+        return target->framebuffer == 0;
+    }), targets.end());
+    if (targets.size() != before) {
+        Debug::Logger::Log("[RenderTargetPool] Freed " + to_string(before - targets.size()) + " idle render target(s)", Debug::LogLevel::INFO);
+    }
+}
+
+void RenderTargetPool::Shutdown() {
+    for (auto& target : targets) {
+        Destroy(*target);
+    }
+    targets.clear();
+}
+
+bool RenderTargetPool::AttachIdBuffer(RenderTarget& target) {
+    if (target.idTexture) return true;
+    if (!target.framebuffer) return false;
+
+    glGenTextures(1, &target.idTexture);
+    glBindTexture(GL_TEXTURE_2D, target.idTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, target.allocatedWidth, target.allocatedHeight, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, target.idTexture, 0);
+    GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0, GL_NONE };
+    glDrawBuffers(2, drawBuffers);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    stats.bytes += uint64_t(target.allocatedWidth) * target.allocatedHeight * 4;
+    if (!complete) {
+        cerr << "[RenderTargetPool] ID attachment is not supported (" << target.allocatedWidth << "x" << target.allocatedHeight << ")" << endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, 0, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteTextures(1, &target.idTexture);
+        target.idTexture = 0;
+        stats.bytes -= uint64_t(target.allocatedWidth) * target.allocatedHeight * 4;
+        return false;
+    }
+    return true;
+}
+
+bool RenderTargetPool::Create(RenderTarget& target, int width, int height) {
+    target.allocatedWidth = width;
+    target.allocatedHeight = height;
+
+    glGenTextures(1, &target.colorTexture);
+    glBindTexture(GL_TEXTURE_2D, target.colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenRenderbuffers(1, &target.depthStencil);
+    glBindRenderbuffer(GL_RENDERBUFFER, target.depthStencil);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &target.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.colorTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depthStencil);
+
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    stats.live++;
+    stats.bytes += uint64_t(width) * height * 8; // RGBA8 + D24S8
+    if (!complete) {
+        cerr << "[RenderTargetPool] Framebuffer is not complete (" << width << "x" << height << ")" << endl;
+        return false;
+    }
+
+    stats.allocations++;
+    Debug::Logger::Log("[RenderTargetPool] Allocated render target " + to_string(width) + "x" + to_string(height), Debug::LogLevel::INFO);
+    return true;
+}
+
+void RenderTargetPool::Destroy(RenderTarget& target) {
+    if (target.framebuffer) {
+        stats.live--;
+        stats.bytes -= uint64_t(target.allocatedWidth) * target.allocatedHeight * 8;
+        glDeleteFramebuffers(1, &target.framebuffer);
+    }
+    if (target.colorTexture) glDeleteTextures(1, &target.colorTexture);
+    if (target.depthStencil) glDeleteRenderbuffers(1, &target.depthStencil);
+    if (target.idTexture) {
+        stats.bytes -= uint64_t(target.allocatedWidth) * target.allocatedHeight * 4;
+        glDeleteTextures(1, &target.idTexture);
+    }
+    target.framebuffer = target.colorTexture = target.depthStencil = target.idTexture = 0;
+    target.inUse = false;
+}
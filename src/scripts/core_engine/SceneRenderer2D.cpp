@@ -6,6 +6,10 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <Debugger.hpp>
+#include <unordered_set>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
 
 using namespace std;
 
@@ -17,11 +21,15 @@ SceneRenderer2D::SceneRenderer2D(int width, int height)
 
 SceneRenderer2D::~SceneRenderer2D() {
     DestroyFramebuffer();
+    if (overdrawQuery) glDeleteQueries(1, &overdrawQuery);
+    if (particleTexture) glDeleteTextures(1, &particleTexture);
+
+    glState.ForgetVertexArray(m_GridVAO);
+    if (m_GridVAO) glDeleteVertexArrays(1, &m_GridVAO);
+    if (m_GridVBO) glDeleteBuffers(1, &m_GridVBO);
     
-    // Clean up shader and VAO/VBO resources
-    if (shaderProgram) glDeleteProgram(shaderProgram);
-    if (gizmoShaderProgram) glDeleteProgram(gizmoShaderProgram);
-    if (gridShaderProgram) glDeleteProgram(gridShaderProgram);
+    // Clean up VAO/VBO resources, shader program dihapus oleh ShaderProgram
+    glState.ForgetVertexArray(quadVAO);
     if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
     if (quadVBO) glDeleteBuffers(1, &quadVBO);
     if (quadEBO) glDeleteBuffers(1, &quadEBO);
@@ -29,70 +37,83 @@ SceneRenderer2D::~SceneRenderer2D() {
 }
 
 void SceneRenderer2D::DestroyFramebuffer() {
-    cout << "DestroyFramebuffer" << endl;
-    if (rbo) {
-        glDeleteRenderbuffers(1, &rbo);
-        rbo = 0;
-    }
-    
-    if (textureID) {
-        glDeleteTextures(1, &textureID);
-        textureID = 0;
-    }
-    
-    if (framebuffer) {
-        glDeleteFramebuffers(1, &framebuffer);
-        framebuffer = 0;
-    }
-
-    if (m_GridVAO) {
-        glDeleteVertexArrays(1, &m_GridVAO);
-        m_GridVAO = 0;
-    }
-    
-    if (m_GridVBO) {
-        glDeleteBuffers(1, &m_GridVBO);
-        m_GridVBO = 0;
+    // Target dikembalikan ke pool, bukan dihapus, supaya bisa dipakai viewport lain
+    if (renderTarget) {
+        RenderTargetPool::Shared().Release(renderTarget);
+        renderTarget = nullptr;
     }
 }
 
 void SceneRenderer2D::InitShaders() {
-    // Create shader program first
-    shaderProgram = CreateShaderProgram("assets/shaders/sprite.vert", "assets/shaders/sprite.frag");
-    if (shaderProgram == 0) {
+    // Semua program di-link sekali, lokasi uniform di-resolve saat itu juga
+    if (!spriteShader.LoadFromFiles("assets/shaders/sprite.vert", "assets/shaders/sprite.frag")) {
         cerr << "Failed to create shader program!" << endl;
         return;
     }
     
-    gizmoShaderProgram = CreateShaderProgram("assets/shaders/gizmo.vert", "assets/shaders/gizmo.frag");
-    if (gizmoShaderProgram == 0) {
+    if (!gizmoShader.LoadFromFiles("assets/shaders/gizmo.vert", "assets/shaders/gizmo.frag")) {
         cerr << "Failed to create gizmo shader program" << endl;
         return;
     }
     
-    gridShaderProgram = CreateShaderProgram("assets/shaders/grid.vert", "assets/shaders/grid.frag");
-    if (gridShaderProgram == 0) {
+    if (!gridShader.LoadFromFiles("assets/shaders/grid.vert", "assets/shaders/grid.frag")) {
         cerr << "Failed to create grid shader program" << endl;
         return;
     }
     
-    checkProgramLinking(shaderProgram);
-    checkProgramLinking(gizmoShaderProgram);
-    checkProgramLinking(gridShaderProgram);
+    if (!spriteBatchShader.LoadFromFiles("assets/shaders/sprite_batch.vert", "assets/shaders/sprite.frag")) {
+        cerr << "Failed to create sprite batch shader program" << endl;
+        return;
+    }
+    
+    if (!spriteInstancedShader.LoadFromFiles("assets/shaders/sprite_instanced.vert", "assets/shaders/sprite.frag")) {
+        cerr << "Failed to create instanced sprite shader program" << endl;
+        return;
+    }
 
-    Debug::Logger::Log("[InitShaders] Shader Program: " + std::to_string(shaderProgram) + " Gizmo Shader Program: " + std::to_string(gizmoShaderProgram) + " Grid Shader Program: " + std::to_string(gridShaderProgram), Debug::LogLevel::SUCCESS);
-}
+    if (!spriteBatchOpaqueShader.LoadFromFiles("assets/shaders/sprite_batch.vert", "assets/shaders/sprite_opaque.frag") ||
+        !spriteInstancedOpaqueShader.LoadFromFiles("assets/shaders/sprite_instanced.vert", "assets/shaders/sprite_opaque.frag")) {
+        cerr << "Failed to create opaque sprite shader program" << endl;
+        return;
+    }
 
-void SceneRenderer2D::checkProgramLinking(GLuint program) {
-    GLint success;
-    GLchar infoLog[1024];
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-        
-    if (!success) {
-        glGetProgramInfoLog(program, 1024, NULL, infoLog);
-        std::cerr << "ERROR::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+    if (!particleShader.LoadFromFiles("assets/shaders/particle.vert", "assets/shaders/particle.frag") ||
+        !particleOverdrawShader.LoadFromFiles("assets/shaders/particle.vert", "assets/shaders/sprite_overdraw.frag")) {
+        cerr << "Failed to create particle shader program" << endl;
+        return;
+    }
+
+    if (!spriteBatchOverdrawShader.LoadFromFiles("assets/shaders/sprite_batch.vert", "assets/shaders/sprite_overdraw.frag") ||
+        !spriteInstancedOverdrawShader.LoadFromFiles("assets/shaders/sprite_instanced.vert", "assets/shaders/sprite_overdraw.frag")) {
+        cerr << "Failed to create overdraw sprite shader program" << endl;
+        return;
     }
-    Debug::Logger::Log("Program " + std::to_string(program) + " linked successfully", Debug::LogLevel::SUCCESS);
+
+    // Projection dan view dibagi lewat satu UBO kamera
+    ShaderProgram* cameraPrograms[] = {
+        &spriteShader, &gizmoShader, &gridShader, &spriteBatchShader, &spriteInstancedShader,
+        &spriteBatchOpaqueShader, &spriteInstancedOpaqueShader, &spriteBatchOverdrawShader, &spriteInstancedOverdrawShader,
+        &particleShader, &particleOverdrawShader
+    };
+    for (ShaderProgram* program : cameraPrograms) {
+        program->BindUniformBlock(CameraUniformBuffer::BlockName, CameraUniformBuffer::BindingPoint);
+    }
+
+    // DrawSprite memakai cutoff lama, pass sprite mengatur cutoff-nya sendiri
+    spriteShader.Use();
+    spriteShader.SetFloat("u_AlphaCutoff", 0.1f);
+
+    if (!gridShader.RequireUniforms({
+            {"uPan", GL_FLOAT_VEC2},
+            {"uZoom", GL_FLOAT},
+            {"uGridColor", GL_FLOAT_VEC3},
+            {"uBgColor", GL_FLOAT_VEC3},
+            {"uGridSize", GL_FLOAT}
+        })) {
+        Debug::Logger::Log("Missing required uniforms in grid shader!", Debug::LogLevel::CRASH);
+    }
+
+    Debug::Logger::Log("[InitShaders] Shader Program: " + std::to_string(spriteShader.GetID()) + " Gizmo Shader Program: " + std::to_string(gizmoShader.GetID()) + " Grid Shader Program: " + std::to_string(gridShader.GetID()), Debug::LogLevel::SUCCESS);
 }
 
 void SceneRenderer2D::Init() {
@@ -102,11 +123,28 @@ void SceneRenderer2D::Init() {
     cout << "Initializing Scene Renderer" << endl;
     
     InitShaders();
+    cameraBuffer.Init();
+    profiler.Init();
+    glGenQueries(1, &overdrawQuery);
     cout << "Shader initialization complete ✅" << endl;
 
     // Initialize vertex data for rendering quads
     InitQuad();
     cout << "Quad initialization complete ✅" << endl;
+
+    // Initialize streaming buffers for batched sprites, debug line dan instance memakai buffer yang sama
+    vertexStream.Init();
+    spriteBatch.Init(glState, vertexStream);
+    spriteInstancer.Init(glState, vertexStream);
+    debugDraw.Init(glState, vertexStream);
+    tilemapRenderer.Init(glState);
+    particleSystem.Init(glState, vertexStream);
+    particleTexture = CreateWhiteTexture();
+    objectPicker.Init();
+    readbackService.Init();
+    // Placeholder streaming dibuat di luar frame karena upload-nya mengubah binding texture
+    textureManager.GetPlaceholderTexture();
+    cout << "Sprite batch initialization complete ✅" << endl;
     
     // Initialize grid buffers
     InitGridBuffers();
@@ -114,75 +152,114 @@ void SceneRenderer2D::Init() {
     
     // Create framebuffer last
     CreateFramebuffer();
-    cout << framebuffer << ", " << textureID << ", " << rbo << endl;
     cout << "Framebuffer creation complete ✅" << endl;
-
-    if (!checkShaderUniforms(gridShaderProgram))
-    {
-        Debug::Logger::Log("[Check Again] Grid Shader Program: " + std::to_string(gridShaderProgram), Debug::LogLevel::WARNING);
-    }
-    Debug::Logger::Log("[Check Again] Grid Shader Program: " + std::to_string(gridShaderProgram), Debug::LogLevel::WARNING);
     // viewPort.getGridShaderProgram(gridShaderProgram);
 }
 
 void SceneRenderer2D::SetViewportSize(int newWidth, int newHeight) {
     if (width == newWidth && height == newHeight) return;
+    redrawRequested = true;
+    pickBufferValid = false;
+    viewportValid = false;
     
     width = newWidth;
     height = newHeight;
     
-    // Recreate framebuffer with new dimensions
+    // Masih muat di target sekarang: cukup viewport/scissor yang berubah, tanpa alokasi
+    if (renderTarget && renderTarget->Fits(width, height)) return;
+
     DestroyFramebuffer();
     CreateFramebuffer();
 }
 
 void SceneRenderer2D::CreateFramebuffer() {
-    // Generate and bind a framebuffer object
-    
-
-    // Create a texture attachment for the framebuffer
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    glGenFramebuffers(1, &framebuffer);
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureID, 0);
-
-    // Create a renderbuffer object for depth and stencil attachments
-    glGenFramebuffers(1, &rbo);
-    glBindFramebuffer(GL_RENDERBUFFER, rbo);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rbo);
-
-    // Check if framebuffer is complete
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        cerr << "Framebuffer is not complete!" << endl;
-    } else {
-        cout << "Framebuffer successfully created with dimensions: " << width << "x" << height << endl;
+    renderTarget = RenderTargetPool::Shared().Acquire(width, height);
+    if (!renderTarget) {
+        cerr << "Failed to acquire render target " << width << "x" << height << endl;
+        return;
     }
+    cout << "Render target " << renderTarget->allocatedWidth << "x" << renderTarget->allocatedHeight
+         << " used for viewport " << width << "x" << height << endl;
+}
 
-    // Unbind the framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+void SceneRenderer2D::UpdateParticles(const Scene& scene, float dt) {
+    // Satu frame tambahan setelah partikel terakhir mati supaya sisanya terhapus dari viewport
+    bool active = particleSystem.Update(scene, dt, &WorkerPool::Shared());
+    if (active || particlesActive) redrawRequested = true;
+    particlesActive = active;
 }
 
 // This Method Is Loop Update For Render Scene To Texture And Use in HandleChilWindow.cpp
 void SceneRenderer2D::RenderSceneToTexture(const Scene& scene) {
-    // Bind our framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-    
-    // Set the viewport to match our framebuffer size
-    glViewport(0, 0, width, height);
-    
-    // Clear the framebuffer
-    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    // Resize dari frame sebelumnya diterapkan di sini, sebelum pass dimulai
+    if (pendingWidth > 0 && pendingHeight > 0) {
+        SetViewportSize(pendingWidth, pendingHeight);
+        pendingWidth = pendingHeight = 0;
+    }
+    SyncEditScene();
+    // Hasil pick dan read baru memakai isi attachment ID frame terakhir, sebelum frame bisa dilewati
+    ProcessPicks();
+    ProcessReadbacks();
+    // Texture yang selesai di-decode di background di-upload dalam budget, sprite-nya berganti dari placeholder
+    if (textureManager.ProcessUploads() > 0) redrawRequested = true;
+
+    // Scene, kamera, grid dan selection sama dengan frame lalu: textureID masih berisi hasil yang benar
+    ViewState viewState = CaptureViewState();
+    if (memcmp(&viewState, &lastViewState, sizeof(ViewState)) != 0) {
+        lastViewState = viewState;
+        viewRevision++;
+        redrawRequested = true;
+    }
+    if (scene.revision != lastSceneRevision) {
+        lastSceneRevision = scene.revision;
+        redrawRequested = true;
+    }
+    if (!redrawRequested) {
+        lastFrameSkipped = true;
+        framesSkipped++;
+        return;
+    }
+    redrawRequested = false;
+    lastFrameSkipped = false;
+
+    // Atlas dibangun sebelum frame dimulai karena upload-nya mengubah binding texture
+    PrepareAtlas(scene);
+    // Texture yang tidak terlihat di frame terakhir di-evict kalau melewati budget memori
+    textureManager.UpdateResidency();
+
+    if (!renderTarget) return;
+    // Attachment dibuat di luar frame karena mengubah binding framebuffer dan texture
+    bool writePickIds = pickingEnabled && !showOverdraw && RenderTargetPool::Shared().AttachIdBuffer(*renderTarget);
+
+    // ImGui dan kode lain mengubah state GL di luar cache, mulai dari nol tiap frame
+    glState.BeginFrame();
+    profiler.BeginFrame(glState.GetStats());
+    // Region stream frame ini, menunggu fence kalau GPU masih memakainya
+    vertexStream.BeginFrame();
+
+    // Bind framebuffer dan clear cukup sekali untuk grid, sprite dan gizmo.
+    // Target bisa lebih besar dari viewport, scissor membatasi clear ke sub-rect yang dipakai.
+    glState.BindFramebuffer(renderTarget->framebuffer);
+    glState.SetViewport(0, 0, width, height);
+    glState.SetScissorTest(true);
+    glState.SetScissor(0, 0, width, height);
+    // Heatmap overdraw dijumlahkan di atas latar hitam
+    if (showOverdraw) glState.SetClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    else glState.SetClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+    glState.SetDepthMask(true);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (writePickIds) {
+        // glClear tidak boleh dipakai untuk attachment integer
+        const GLuint noObject[4] = { 0, 0, 0, 0 };
+        SetPickOutput(true);
+        glClearBufferuiv(GL_COLOR, 1, noObject);
+        SetPickOutput(false);
+    }
+    glState.SetDepthTest(false);
     
     // Enable alpha blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.SetBlend(true);
+    glState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Render each game object in the scene
     glm::mat4 projection = glm::ortho(
@@ -193,73 +270,153 @@ void SceneRenderer2D::RenderSceneToTexture(const Scene& scene) {
     
     glm::mat4 view = glm::translate(glm::mat4(1.0f), 
                                   glm::vec3(-cameraPosition.x, -cameraPosition.y, 0.0f));
+
+    // Kamera di-upload sekali per frame, dipakai sprite, gizmo dan grid
+    cameraBuffer.Update(projection, view, (float)width, (float)height, cameraZoom);
     
     // Draw grid if enabled
-    DrawGrid(projection, view);
+    if (!showOverdraw) {
+        profiler.BeginPass(RenderPass::GRID, glState.GetStats());
+        DrawGrid(projection, view);
+        profiler.AddDraws(RenderPass::GRID, 1, 4);
+        profiler.EndPass(RenderPass::GRID, glState.GetStats());
+    }
+
+    // Rect kamera, sama dengan ortho box di atas
+    float halfViewW = width * 0.5f / cameraZoom;
+    float halfViewH = height * 0.5f / cameraZoom;
+
+    // Tilemap di belakang semua sprite, satu draw call per chunk terlihat
+    if (!scene.tilemaps.empty()) {
+        profiler.BeginPass(RenderPass::TILES, glState.GetStats());
+        if (showOverdraw) glState.SetBlendFunc(GL_ONE, GL_ONE);
+        tilemapRenderer.Render(scene, textureManager, showOverdraw ? spriteBatchOverdrawShader : spriteBatchShader,
+                               cameraPosition.x - halfViewW, cameraPosition.y - halfViewH,
+                               cameraPosition.x + halfViewW, cameraPosition.y + halfViewH);
+        const TilemapStats& tileStats = tilemapRenderer.GetStats();
+        profiler.AddDraws(RenderPass::TILES, tileStats.drawCalls, tileStats.tilesDrawn * 4);
+        glState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        profiler.EndPass(RenderPass::TILES, glState.GetStats());
+    }
     
-    // Draw all objects in the scene
-    for (const auto& obj : scene.objects) {
-        GLuint tex = textureManager.LoadTexture(obj.spritePath);
-        if (tex != 0) {
-            DrawSprite(tex, obj.x, obj.y, obj.width, obj.height, 
-                      obj.rotation, obj.scaleX, obj.scaleY);
+    // Pass sprite mencakup culling, sorting dan submit
+    profiler.BeginPass(RenderPass::SPRITES, glState.GetStats());
+
+    // Buang object di luar rect kamera sebelum submit
+    WorkerPool& workers = WorkerPool::Shared();
+    spriteCuller.Cull(scene.objects, scene.revision,
+                      cameraPosition.x - halfViewW, cameraPosition.y - halfViewH,
+                      cameraPosition.x + halfViewW, cameraPosition.y + halfViewH, &workers);
+
+    // Urutkan object terlihat berdasarkan layer, depth, blend, shader dan texture
+    auto prepareStart = chrono::steady_clock::now();
+    objectPicker.PreserveOrder(renderQueue);
+    PrepareSpriteList(scene, workers);
+    auto emitStart = chrono::steady_clock::now();
+
+    // Worker menulis vertex langsung ke StreamBuffer di posisi antriannya. Depth diambil dari
+    // posisi itu, jadi depth test memberi hasil yang sama dengan urutan painter.
+    size_t spriteCount = renderQueue.Size();
+    bool emitted = false;
+    if (spriteRenderPath == SpriteRenderPath::INSTANCED) {
+        spriteInstancer.ResetStats();
+        SpriteInstance* out = spriteInstancer.BeginDirect(spriteCount);
+        if (out) {
+            workers.ParallelFor(spriteCount, MinPrepareChunk, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t index = renderQueue.IndexAt(i);
+                    const GameObject& obj = scene.objects[index];
+                    SpriteInstancer::WriteInstance(&out[i], obj.x, obj.y, obj.width, obj.height,
+                                                   obj.rotation, obj.scaleX, obj.scaleY, resolvedSprites[index].uvRect,
+                                                   SpriteDepth(i, spriteCount));
+                }
+            });
+            emitted = true;
+        }
+    } else {
+        spriteBatch.ResetStats();
+        SpriteVertex* out = spriteBatch.BeginDirect(spriteCount);
+        if (out) {
+            workers.ParallelFor(spriteCount, MinPrepareChunk, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t index = renderQueue.IndexAt(i);
+                    const GameObject& obj = scene.objects[index];
+                    SpriteBatch::WriteQuad(&out[i * 4], obj.x, obj.y, obj.width, obj.height,
+                                           obj.rotation, obj.scaleX, obj.scaleY, resolvedSprites[index].uvRect,
+                                           SpriteDepth(i, spriteCount));
+                }
+            });
+            emitted = true;
         }
     }
-    
-    // Draw selection gizmo for selected object
-    if (selectedObject != nullptr) {
-        DrawSelectionGizmo(*selectedObject);
+    if (emitted) {
+        BuildSpriteRuns();
+        if (writePickIds) SetPickOutput(true);
+        DrawSpritePasses();
+        if (writePickIds) SetPickOutput(false);
     }
+    prepareStats.threads = workers.GetThreadCount();
+    prepareStats.resolveMs = chrono::duration<float, milli>(emitStart - prepareStart).count();
+    prepareStats.emitMs = chrono::duration<float, milli>(chrono::steady_clock::now() - emitStart).count();
+    const SpriteBatchStats& spriteStats = GetSpriteBatchStats();
+    profiler.AddDraws(RenderPass::SPRITES, spriteStats.drawCalls, spriteStats.spritesSubmitted * 4);
+    profiler.EndPass(RenderPass::SPRITES, glState.GetStats());
 
-    // Debug::Logger::Log("[Debug] camZoom: " + std::to_string(cameraZoom)
-    //       + " camPos: (" + std::to_string(cameraPosition.x) + ", " + std::to_string(cameraPosition.y) + ")"
-    //       + " width: " + std::to_string(width) + " height: " + std::to_string(height)
-    //       + " gridSize: " + std::to_string(gridSize)
-    //       + " VAO: " + std::to_string(m_GridVAO) + " VBO: " + std::to_string(m_GridVBO)
-    //       + "\nMax Grid Lines: " + std::to_string(m_MaxGridLines)
-    //       + " Current Shader: " + std::to_string(shaderProgram)
-    //       + " Current Gizmo Shader: " + std::to_string(gizmoShaderProgram)
-    //       + " Current Grid Shader: " + std::to_string(gridShaderProgram), Debug::LogLevel::INFO);
-
+    // Partikel di atas semua sprite, satu draw instanced per run texture + blend
+    if (!scene.emitters.empty()) {
+        profiler.BeginPass(RenderPass::PARTICLES, glState.GetStats());
+        particleSystem.Render(scene, showOverdraw ? particleOverdrawShader : particleShader, textureManager,
+                              particleTexture, showOverdraw, &workers);
+        const ParticleStats& particleStats = particleSystem.GetStats();
+        profiler.AddDraws(RenderPass::PARTICLES, particleStats.drawCalls, particleStats.liveParticles * 4);
+        profiler.EndPass(RenderPass::PARTICLES, glState.GetStats());
+    }
     
-    // Disable blending when done
-    glDisable(GL_BLEND);
+    // Selection dan bounds dikumpulkan di DebugDraw lalu di-flush dengan dua draw call paling banyak
+    GameObject* selectedObject = GetSelectedObject();
+    if (selectedObject != nullptr || showBounds) {
+        profiler.BeginPass(RenderPass::GIZMO, glState.GetStats());
+        debugDraw.ResetStats();
+        if (showBounds) DrawObjectBounds(scene);
+        if (selectedObject != nullptr) DrawSelectionGizmo(*selectedObject);
+        debugDraw.Flush(gizmoShader);
+        const DebugDrawStats& debugStats = debugDraw.GetStats();
+        profiler.AddDraws(RenderPass::GIZMO, debugStats.drawCalls, debugStats.lineVertices + debugStats.pointVertices);
+        profiler.EndPass(RenderPass::GIZMO, glState.GetStats());
+    }
     
-    // Unbind the framebuffer
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    // Disable blending when done, ImGui memakai default framebuffer
+    glState.SetBlend(false);
+    glState.SetDepthTest(false);
+    glState.SetDepthMask(true);
+    glState.SetScissorTest(false);
+    glState.BindVertexArray(0);
+    glState.BindFramebuffer(0);
+    vertexStream.EndFrame();
+    pickBufferValid = writePickIds;
+    // Stream penuh berarti ada geometry yang tidak tergambar, ulangi dengan region yang lebih besar
+    viewportValid = !vertexStream.HasOverflowed();
+    if (vertexStream.HasOverflowed()) redrawRequested = true;
+    profiler.EndFrame();
 }
 
 void SceneRenderer2D::DrawGrid(const glm::mat4& projection, const glm::mat4& view) {
-        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-        glViewport(0, 0, width, height);
-        glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        
-        glUseProgram(gridShaderProgram);
-
-        string info = to_string(gridShaderProgram);
-        string info2 = to_string(textureID);
-        // ImGui::Text("Grid Shader Program: %s | And Texture ID: %s", info.c_str(), info2.c_str());
-
-        if (!checkShaderUniforms(gridShaderProgram)) {
-            Debug::Logger::Log("Missing required uniforms in grid shader!", Debug::LogLevel::CRASH);
-            return;
-        }
+        // Framebuffer, viewport dan clear sudah diatur oleh RenderSceneToTexture
+        gridShader.Use(glState);
         
-        // Set uniform values
-        glUniform2f(glGetUniformLocation(gridShaderProgram, "uViewport"), width, height);
-        glUniform2f(glGetUniformLocation(gridShaderProgram, "uPan"), pan.x, pan.y);
-        glUniform1f(glGetUniformLocation(gridShaderProgram, "uZoom"), zoom);
-        glUniform3f(glGetUniformLocation(gridShaderProgram, "uGridColor"), gridColor.x, gridColor.y, gridColor.z);
-        glUniform3f(glGetUniformLocation(gridShaderProgram, "uBgColor"), bgColor.x, bgColor.y, bgColor.z);
-        glUniform1f(glGetUniformLocation(gridShaderProgram, "uGridSize"), gridSize);
+        // Set uniform values, viewport datang dari UBO kamera dan nilai yang sama tidak di-upload ulang
+        gridShader.SetVec2("uPan", glm::vec2(pan.x, pan.y));
+        gridShader.SetFloat("uZoom", zoom);
+        gridShader.SetVec3("uGridColor", glm::vec3(gridColor.x, gridColor.y, gridColor.z));
+        gridShader.SetVec3("uBgColor", glm::vec3(bgColor.x, bgColor.y, bgColor.z));
+        gridShader.SetFloat("uGridSize", gridSize);
         
-        glBindVertexArray(quadVAO);
+        glState.BindVertexArray(quadVAO);
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        glBindVertexArray(0);
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
         gridSize = 49.426f;
-   
+}
+
+void SceneRenderer2D::DrawViewportImage() {
         // Controls
         // if (ImGui::CollapsingHeader("Viewport Settings")) {
         //     ImGui::SliderFloat("Zoom", &zoom, 1.0f, 10.0f);
@@ -282,20 +439,19 @@ void SceneRenderer2D::DrawGrid(const glm::mat4& projection, const glm::mat4& vie
         // Ensure square aspect ratio if needed
         // viewportSize.x = viewportSize.y = min(viewportSize.x, viewportSize.y);
         
-        // Update viewport dimensions if window resized
-        if (width != static_cast<int>(viewportSize.x) || 
-            height != static_cast<int>(viewportSize.y)) {
-            
-            width = static_cast<int>(viewportSize.x);
-            height = static_cast<int>(viewportSize.y);
-            
-            // Resize framebuffer texture
-            glBindTexture(GL_TEXTURE_2D, textureID);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        // Update viewport dimensions if window resized, framebuffer dibuat ulang di frame berikutnya
+        int requestedWidth = static_cast<int>(viewportSize.x);
+        int requestedHeight = static_cast<int>(viewportSize.y);
+        if (requestedWidth > 0 && requestedHeight > 0 &&
+            (width != requestedWidth || height != requestedHeight)) {
+            pendingWidth = requestedWidth;
+            pendingHeight = requestedHeight;
         }
         
         // Draw the viewport texture
-        ImGui::Image((ImTextureID)(intptr_t)textureID, viewportSize);
+        // Hanya sub-rect yang dirender yang ditampilkan
+        glm::vec2 uvMax = GetViewportUV();
+        ImGui::Image((ImTextureID)(intptr_t)GetViewportTextureID(), viewportSize, ImVec2(0.0f, 0.0f), ImVec2(uvMax.x, uvMax.y));
         
         // Handle mouse interactions within viewport
         if (ImGui::IsItemHovered()) {
@@ -356,8 +512,21 @@ void SceneRenderer2D::DrawGrid(const glm::mat4& projection, const glm::mat4& vie
                 (mousePosInViewport.x - viewportSize.x * 0.5f) / zoom + pan.x,
                 (mousePosInViewport.y - viewportSize.y * 0.5f) / zoom + pan.y
             );
+
+            // Object di bawah kursor dari attachment ID. Baris 0 texture tampil paling atas.
+            if (pickingEnabled) {
+                int pickX = static_cast<int>(mousePosInViewport.x);
+                int pickY = static_cast<int>(mousePosInViewport.y);
+                RequestPick(pickX, pickY, PickPurpose::HOVER);
+                if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) RequestPick(pickX, pickY, PickPurpose::SELECT);
+            }
+
             ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10, 10));
-            ImGui::SetTooltip("Pos: (%.1f, %.1f)", worldPos.x, worldPos.y);
+            if (hoveredObjectIndex >= 0 && hoveredObjectIndex < (int)editScene->objects.size()) {
+                ImGui::SetTooltip("Pos: (%.1f, %.1f)\n%s", worldPos.x, worldPos.y, editScene->objects[hoveredObjectIndex].name.c_str());
+            } else {
+                ImGui::SetTooltip("Pos: (%.1f, %.1f)", worldPos.x, worldPos.y);
+            }
             ImGui::PopStyleVar(1);
         }
         
@@ -366,86 +535,9 @@ void SceneRenderer2D::DrawGrid(const glm::mat4& projection, const glm::mat4& vie
         //             zoom, pan.x, pan.y, gridSize);
 }
 
-bool SceneRenderer2D::checkShaderUniforms(GLuint program) {
-    // Debug::Logger::Log("Checking shader uniforms for program: " + std::to_string(program), Debug::LogLevel::INFO);
-    
-    bool allValid = true;
-
-    // Store uniform names and their expected types
-    const std::vector<std::pair<const char*, const char*>> uniforms = {
-        {"uViewport", "vec2"},
-        {"uPan", "vec2"},
-        {"uZoom", "float"},
-        {"uGridColor", "vec3"},
-        {"uBgColor", "vec3"},
-        {"uGridSize", "float"}
-    };
-
-    // Check each uniform
-    for (const auto& uniform : uniforms) {
-        try {
-            validateUniformLocation(program, uniform.first, uniform.second);
-        } catch (const std::runtime_error& e) {
-            Debug::Logger::Log(e.what(), Debug::LogLevel::CRASH);
-            allValid = false;
-        }
-    }
-
-    return allValid;
-}
-
-void SceneRenderer2D::validateUniformLocation(GLuint program, const char* uniformName, const char* uniformType) {
-    GLint location = glGetUniformLocation(program, uniformName);
-    
-    if (location == -1) {
-        throw std::runtime_error("Uniform '" + std::string(uniformName) + 
-                               "' (" + uniformType + ") not found in shader program");
-    }
-
-    // Get uniform info
-    GLint size;
-    GLenum type;
-    GLchar actualName[128];
-    glGetActiveUniform(program, location, sizeof(actualName), nullptr, &size, &type, actualName);
-
-    std::string typeStr;
-    switch (type) {
-        case GL_FLOAT: typeStr = "float"; break;
-        case GL_FLOAT_VEC2: typeStr = "vec2"; break;
-        case GL_FLOAT_VEC3: typeStr = "vec3"; break;
-        case GL_FLOAT_VEC4: typeStr = "vec4"; break;
-        default: typeStr = "unknown";
-    }
-
-    // Debug::Logger::Log("Found uniform '" + std::string(uniformName) + 
-    //                   "' at location " + std::to_string(location) + 
-    //                   " (type: " + typeStr + ")", Debug::LogLevel::SUCCESS);
-}
-
 void SceneRenderer2D::DrawSelectionGizmo(const GameObject& obj) {
-    cout << "Draw Gizmo Shader" << endl;
-    // string info = "Name: " + obj.name + " Position x: " + std::to_string(obj.x) + " Position y: " + std::to_string(obj.y) + " Sprite Path: " + obj.spritePath;
-    // cout << info << endl;
-
-    glUseProgram(gizmoShaderProgram);
-    
-    // Set color for selection outline (yellow)
-    glUniform4f(glGetUniformLocation(gizmoShaderProgram, "u_Color"), 1.0f, 1.0f, 0.0f, 1.0f);
-    
-    // Set projection and view matrices
-    glm::mat4 projection = glm::ortho(
-        -width * 0.5f / cameraZoom, width * 0.5f / cameraZoom,
-        -height * 0.5f / cameraZoom, height * 0.5f / cameraZoom,
-        -1.0f, 1.0f
-    );
-    
-    glm::mat4 view = glm::translate(glm::mat4(1.0f), 
-        glm::vec3(-cameraPosition.x, -cameraPosition.y, 0.0f));
-
-    glUniformMatrix4fv(glGetUniformLocation(gizmoShaderProgram, "u_Projection"), 
-        1, GL_FALSE, glm::value_ptr(projection));
-    glUniformMatrix4fv(glGetUniformLocation(gizmoShaderProgram, "u_View"), 
-        1, GL_FALSE, glm::value_ptr(view));
+    // Hanya menambah shape ke DebugDraw, upload dan draw dilakukan sekali di akhir pass gizmo
+    const glm::vec4 selectionColor(1.0f, 1.0f, 0.0f, 1.0f);
     
     // Calculate corners with margin
     float margin = 2.0f / cameraZoom;
@@ -454,62 +546,31 @@ void SceneRenderer2D::DrawSelectionGizmo(const GameObject& obj) {
     float x2 = obj.x + obj.width * obj.scaleX + margin;
     float y2 = obj.y + obj.height * obj.scaleY + margin;
     
-    // Create rectangle vertices (5 points to close the loop)
-    float vertices[] = {
-        x1, y1,  // Bottom left
-        x2, y1,  // Bottom right
-        x2, y2,  // Top right
-        x1, y2,  // Top left
-        x1, y1   // Back to start to close the loop
-    };
-    
-    // Create and bind VAO/VBO
-    GLuint gizmoVAO, gizmoVBO;
-    glGenVertexArrays(1, &gizmoVAO);
-    glGenBuffers(1, &gizmoVBO);
-    
-    glBindVertexArray(gizmoVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, gizmoVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    
-    // Set up vertex attributes
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    // Enable line smoothing for better appearance
-    glEnable(GL_LINE_SMOOTH);
-    glLineWidth(2.0f);
-    
-    // Draw the selection rectangle
-    glDrawArrays(GL_LINE_STRIP, 0, 5);
+    debugDraw.Rect(glm::vec2(x1, y1), glm::vec2(x2, y2), selectionColor);
     
     // Draw handles for rotation/scaling if in appropriate mode
     if (currentMode == EditMode::ROTATE || currentMode == EditMode::SCALE) {
-        // Calculate handle positions (corners and midpoints)
-        float handlePositions[] = {
-            x1, y1,      // Bottom left
-            (x1+x2)/2, y1, // Bottom middle
-            x2, y1,      // Bottom right
-            x2, (y1+y2)/2, // Right middle
-            x2, y2,      // Top right
-            (x1+x2)/2, y2, // Top middle
-            x1, y2,      // Top left
-            x1, (y1+y2)/2  // Left middle
+        // Corners and midpoints
+        const glm::vec2 handles[] = {
+            { x1, y1 }, { (x1 + x2) / 2, y1 },
+            { x2, y1 }, { x2, (y1 + y2) / 2 },
+            { x2, y2 }, { (x1 + x2) / 2, y2 },
+            { x1, y2 }, { x1, (y1 + y2) / 2 }
         };
-        
-        // Update buffer with handle positions
-        glBufferData(GL_ARRAY_BUFFER, sizeof(handlePositions), handlePositions, GL_STATIC_DRAW);
-        
-        // Draw handles as points
-        glPointSize(8.0f);
-        glDrawArrays(GL_POINTS, 0, 8);
+        for (const glm::vec2& handle : handles) {
+            debugDraw.Point(handle, selectionColor);
+        }
+    }
+}
+
+void SceneRenderer2D::DrawObjectBounds(const Scene& scene) {
+    // Bounds sprite yang lolos culling, termasuk rotasi
+    const glm::vec4 boundsColor(0.0f, 1.0f, 0.5f, 0.6f);
+    for (uint32_t index : spriteCuller.GetVisible()) {
+        const GameObject& obj = scene.objects[index];
+        glm::vec2 halfSize(obj.width * obj.scaleX * 0.5f, obj.height * obj.scaleY * 0.5f);
+        debugDraw.RotatedRect(glm::vec2(obj.x + halfSize.x, obj.y + halfSize.y), halfSize, obj.rotation, boundsColor);
     }
-    
-    // Cleanup
-    glDisable(GL_LINE_SMOOTH);
-    glBindVertexArray(0);
-    glDeleteVertexArrays(1, &gizmoVAO);
-    glDeleteBuffers(1, &gizmoVBO);
 }
 
 void SceneRenderer2D::InitQuad() {
@@ -558,12 +619,7 @@ void SceneRenderer2D::InitQuad() {
 
 void SceneRenderer2D::DrawSprite(GLuint textureID, float x, float y, float width, float height, 
                                float rotation, float scaleX, float scaleY) {
-    glUseProgram(shaderProgram);
-    
-    // Calculate orthographic projection matrix (similar to Unity's 2D camera)
-    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(width), 
-                                      static_cast<float>(height), 0.0f, 
-                                      -1.0f, 1.0f);
+    spriteShader.Use(glState);
     
     // Create model matrix for transformations
     glm::mat4 model = glm::mat4(1.0f);
@@ -579,59 +635,360 @@ void SceneRenderer2D::DrawSprite(GLuint textureID, float x, float y, float width
     // Scale the sprite
     model = glm::scale(model, glm::vec3(width * scaleX, height * scaleY, 1.0f));
     
-    // Set uniforms
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "u_Projection"), 1, GL_FALSE, 
-                       glm::value_ptr(projection));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "u_Model"), 1, GL_FALSE, 
-                       glm::value_ptr(model));
+    // Set uniforms, projection dan view dari UBO kamera
+    spriteShader.SetMat4("u_Model", model);
     
     // Bind texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glUniform1i(glGetUniformLocation(shaderProgram, "u_Texture"), 0);
+    glState.BindTexture(0, textureID);
+    spriteShader.SetInt("u_Texture", 0);
     
     // Draw the quad
-    glBindVertexArray(quadVAO);
+    glState.BindVertexArray(quadVAO);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+}
+
+SceneRenderer2D::ViewState SceneRenderer2D::CaptureViewState() const {
+    // Dibandingkan dengan memcmp, jadi padding harus nol
+    ViewState state;
+    memset(&state, 0, sizeof(ViewState));
+    state.cameraX = cameraPosition.x;
+    state.cameraY = cameraPosition.y;
+    state.cameraZoom = cameraZoom;
+    state.zoom = zoom;
+    state.panX = pan.x;
+    state.panY = pan.y;
+    state.gridSize = gridSize;
+    memcpy(state.gridColor, &gridColor.x, sizeof(state.gridColor));
+    memcpy(state.bgColor, &bgColor.x, sizeof(state.bgColor));
+    state.width = width;
+    state.height = height;
+    state.gridVisible = gridVisible ? 1 : 0;
+    state.editMode = static_cast<int>(currentMode);
+    state.renderPath = static_cast<int>(spriteRenderPath);
+    state.showBounds = showBounds ? 1 : 0;
+    state.earlyDepth = earlyDepth ? 1 : 0;
+    state.showOverdraw = showOverdraw ? 1 : 0;
+    const GameObject* selectedObject = GetSelectedObject();
+    state.selected = selectedObject;
+    if (selectedObject) {
+        state.selectedX = selectedObject->x;
+        state.selectedY = selectedObject->y;
+        state.selectedWidth = selectedObject->width * selectedObject->scaleX;
+        state.selectedHeight = selectedObject->height * selectedObject->scaleY;
+    }
+    return state;
+}
+
+void SceneRenderer2D::PrepareAtlas(const Scene& scene) {
+    // Cek ulang setiap scene diedit (revisi berubah), termasuk sprite yang diganti tanpa mengubah jumlah object
+    if (scene.id == atlasSceneId && scene.revision == atlasSceneRevision) return;
+    bool sameScene = scene.id == atlasSceneId;
+    atlasSceneId = scene.id;
+    atlasSceneRevision = scene.revision;
+
+    std::unordered_set<std::string> uniquePaths;
+    for (const auto& obj : scene.objects) {
+        if (!obj.spritePath.empty()) uniquePaths.insert(obj.spritePath);
+    }
+    std::vector<std::string> paths(uniquePaths.begin(), uniquePaths.end());
+    std::sort(paths.begin(), paths.end());
+    // Edit biasa (geser, ubah warna) tidak mengubah set path, atlas dan handle tetap
+    if (sameScene && paths == atlasScenePaths) return;
+    atlasScenePaths = paths;
+    if (paths != textureAtlas.GetSources()) textureAtlas.Build(paths, atlasCacheDir);
+
+    // Handle semua object di-resolve ulang: region atlas bisa berubah dan referensi dihitung ulang
+    // dari scene sekarang, texture scene lama tidak dipegang lagi dan jadi kandidat eviction pertama
+    textureManager.InvalidateHandles();
+
+    // Scene baru: semua texture di luar atlas mulai di-decode sekarang, bukan saat pertama terlihat
+    PrefetchSceneTextures(scene);
+}
+
+void SceneRenderer2D::PrefetchSceneTextures(const Scene& scene) {
+    // Resolve handle sprite sekaligus memulai decode texture di luar atlas
+    spriteHandles.resize(scene.objects.size());
+    for (size_t i = 0; i < scene.objects.size(); i++) {
+        const GameObject& obj = scene.objects[i];
+        SpriteHandle& cached = spriteHandles[i];
+        if (cached.spriteRevision == obj.spriteRevision && textureManager.ResolveHandle(cached.handle)) continue;
+        cached.handle = AcquireSpriteHandle(obj.spritePath);
+        cached.spriteRevision = obj.spriteRevision;
+    }
+
+    std::unordered_set<std::string> uniquePaths;
+    for (const auto& map : scene.tilemaps) uniquePaths.insert(map.tilesetPath);
+    for (const auto& emitter : scene.emitters) uniquePaths.insert(emitter.texturePath);
+    textureManager.Prefetch(std::vector<std::string>(uniquePaths.begin(), uniquePaths.end()));
+}
+
+void SceneRenderer2D::FinishTextureStreaming() {
+    if (textureManager.FinishStreaming() > 0) redrawRequested = true;
+}
+
+TextureHandle SceneRenderer2D::AcquireSpriteHandle(const std::string& spritePath) {
+    // Sprite kecil diambil dari atlas, sisanya tetap texture sendiri dengan UV penuh
+    GLuint texture;
+    glm::vec4 uvRect;
+    SpriteAlphaMode alphaMode;
+    if (textureAtlas.Lookup(spritePath, texture, uvRect, &alphaMode)) {
+        return textureManager.AcquireRegionHandle(spritePath, texture, uvRect, alphaMode);
+    }
+    // Tidak menunggu disk: slot menunjuk placeholder sampai hasil decode di-upload oleh ProcessUploads
+    return textureManager.AcquireHandle(spritePath);
+}
+
+void SceneRenderer2D::PrepareSpriteList(const Scene& scene, WorkerPool& workers) {
+    const vector<uint32_t>& visible = spriteCuller.GetVisible();
+    resolvedSprites.resize(scene.objects.size());
+    spriteHandles.resize(scene.objects.size());
+
+    // Worker hanya membaca tabel slot lewat handle, sprite dengan handle basi dicatat per chunk
+    size_t chunks = workers.ChunkCount(visible.size(), MinPrepareChunk);
+    if (missedSprites.size() < chunks) missedSprites.resize(chunks);
+    workers.ParallelFor(visible.size(), MinPrepareChunk, [&](size_t chunk, size_t begin, size_t end) {
+        vector<uint32_t>& missed = missedSprites[chunk];
+        missed.clear();
+        for (size_t i = begin; i < end; i++) {
+            uint32_t index = visible[i];
+            // Object di index ini diganti atau sprite-nya berubah: handle lama bukan miliknya lagi
+            const SpriteHandle& cached = spriteHandles[index];
+            const TextureSlot* slot = cached.spriteRevision == scene.objects[index].spriteRevision
+                ? textureManager.ResolveHandle(cached.handle) : nullptr;
+            if (!slot) {
+                missed.push_back(index);
+                continue;
+            }
+            ResolvedSprite& sprite = resolvedSprites[index];
+            sprite.texture = slot->texture;
+            sprite.uvRect = slot->uvRect;
+            sprite.alphaMode = slot->alphaMode;
+        }
+    });
+
+    // Resolve path dan request texture baru harus di thread GL
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        for (uint32_t index : missedSprites[chunk]) {
+            const GameObject& obj = scene.objects[index];
+            SpriteHandle& cached = spriteHandles[index];
+            cached.handle = AcquireSpriteHandle(obj.spritePath);
+            cached.spriteRevision = obj.spriteRevision;
+            const TextureSlot* slot = textureManager.ResolveHandle(cached.handle);
+            ResolvedSprite& sprite = resolvedSprites[index];
+            sprite.texture = slot->texture;
+            sprite.uvRect = slot->uvRect;
+            sprite.alphaMode = slot->alphaMode;
+        }
+    }
+
+    ShaderProgram& spriteProgram = spriteRenderPath == SpriteRenderPath::INSTANCED ? spriteInstancedShader : spriteBatchShader;
+    renderQueue.Begin(scene.objects.size());
+    for (uint32_t index : visible) {
+        const GameObject& obj = scene.objects[index];
+        const ResolvedSprite& sprite = resolvedSprites[index];
+        if (sprite.texture == 0) continue;
+        textureManager.TouchHandle(spriteHandles[index].handle);
+        // Sprite yang di-blend tidak diurutkan per texture: key sama jatuh ke index, jadi urutan scene tetap.
+        // Dengan early depth, translucent di bucket blend 1 supaya selalu di atas opaque/cutout layer/depth yang sama.
+        bool translucent = sprite.alphaMode == SpriteAlphaMode::TRANSLUCENT;
+        uint64_t key = !earlyDepth ? RenderQueue::MakeKey(obj.layer, obj.depth, 0, spriteProgram.GetID(), 0)
+                     : translucent ? RenderQueue::MakeKey(obj.layer, obj.depth, 1, spriteProgram.GetID(), 0)
+                     : RenderQueue::MakeKey(obj.layer, obj.depth, 0, spriteProgram.GetID(), sprite.texture);
+        renderQueue.Push(index, key);
+    }
+    renderQueue.Sort();
+}
+
+void SceneRenderer2D::BuildSpriteRuns() {
+    solidRuns.clear();
+    cutoutRuns.clear();
+    translucentRuns.clear();
+    overdrawStats.solid = overdrawStats.cutout = overdrawStats.translucent = 0;
+
+    // Translucent (atau semua sprite tanpa early depth) mengikuti urutan antrian, belakang-ke-depan
+    for (size_t i = 0; i < renderQueue.Size(); i++) {
+        const ResolvedSprite& sprite = resolvedSprites[renderQueue.IndexAt(i)];
+        if (sprite.alphaMode == SpriteAlphaMode::SOLID) overdrawStats.solid++;
+        else if (sprite.alphaMode == SpriteAlphaMode::CUTOUT) overdrawStats.cutout++;
+        else overdrawStats.translucent++;
+        if (earlyDepth && sprite.alphaMode != SpriteAlphaMode::TRANSLUCENT) continue;
+
+        if (translucentRuns.empty() || translucentRuns.back().texture != sprite.texture ||
+            translucentRuns.back().first + translucentRuns.back().count != i) {
+            translucentRuns.push_back({ sprite.texture, static_cast<uint32_t>(i), 0 });
+        }
+        translucentRuns.back().count++;
+    }
+    if (!earlyDepth) return;
+
+    // Solid dan cutout dari depan ke belakang. Run tetap menunjuk rentang naik di stream,
+    // urutan di dalam satu run tidak penting karena depth test yang menentukan hasil.
+    for (size_t i = renderQueue.Size(); i-- > 0;) {
+        const ResolvedSprite& sprite = resolvedSprites[renderQueue.IndexAt(i)];
+        if (sprite.alphaMode == SpriteAlphaMode::TRANSLUCENT) continue;
+
+        vector<SpriteRun>& runs = sprite.alphaMode == SpriteAlphaMode::SOLID ? solidRuns : cutoutRuns;
+        if (!runs.empty() && runs.back().texture == sprite.texture && runs.back().first == i + 1) {
+            runs.back().first--;
+            runs.back().count++;
+        } else {
+            runs.push_back({ sprite.texture, static_cast<uint32_t>(i), 1 });
+        }
+    }
+}
+
+void SceneRenderer2D::DrawSpriteRuns(ShaderProgram& program, const vector<SpriteRun>& runs) {
+    if (spriteRenderPath == SpriteRenderPath::INSTANCED) spriteInstancer.DrawRuns(program, runs);
+    else spriteBatch.DrawRuns(program, runs);
+}
+
+void SceneRenderer2D::DrawSpritePasses() {
+    bool instanced = spriteRenderPath == SpriteRenderPath::INSTANCED;
+    ShaderProgram& overdrawProgram = instanced ? spriteInstancedOverdrawShader : spriteBatchOverdrawShader;
+    ShaderProgram& opaqueProgram = showOverdraw ? overdrawProgram : (instanced ? spriteInstancedOpaqueShader : spriteBatchOpaqueShader);
+    ShaderProgram& blendProgram = showOverdraw ? overdrawProgram : (instanced ? spriteInstancedShader : spriteBatchShader);
+
+    // Hasil query frame lalu, dibaca tanpa menunggu GPU
+    if (overdrawQueryPending) {
+        GLuint available = 0;
+        glGetQueryObjectuiv(overdrawQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 samples = 0;
+            glGetQueryObjectui64v(overdrawQuery, GL_QUERY_RESULT, &samples);
+            overdrawStats.overdraw = float(double(samples) / (double(width) * height));
+            overdrawQueryPending = false;
+        }
+    }
+    bool measure = showOverdraw && overdrawQuery && !overdrawQueryPending;
+    if (!showOverdraw) overdrawStats.overdraw = -1.0f;
+    if (measure) glBeginQuery(GL_SAMPLES_PASSED, overdrawQuery);
+
+    // Heatmap: setiap fragment yang lolos menambah warna, termasuk di pass opaque
+    if (showOverdraw) glState.SetBlendFunc(GL_ONE, GL_ONE);
+
+    if (earlyDepth) {
+        // Solid dan cutout menulis depth dari depan ke belakang, fragment di belakangnya dibuang early-Z
+        glState.SetDepthTest(true);
+        glState.SetDepthMask(true);
+        glState.SetBlend(showOverdraw);
+
+        opaqueProgram.Use(glState);
+        if (showOverdraw) opaqueProgram.SetFloat("u_AlphaCutoff", 0.0f);
+        DrawSpriteRuns(opaqueProgram, solidRuns);
+
+        blendProgram.Use(glState);
+        blendProgram.SetFloat("u_AlphaCutoff", 0.5f);
+        DrawSpriteRuns(blendProgram, cutoutRuns);
+
+        // Translucent tetap dites terhadap depth sprite opaque di depannya, tapi tidak menulis
+        glState.SetDepthMask(false);
+        glState.SetBlend(true);
+    }
+
+    blendProgram.Use(glState);
+    blendProgram.SetFloat("u_AlphaCutoff", 0.1f);
+    DrawSpriteRuns(blendProgram, translucentRuns);
+
+    if (measure) {
+        glEndQuery(GL_SAMPLES_PASSED);
+        overdrawQueryPending = true;
+    }
+    glState.SetDepthTest(false);
+    glState.SetDepthMask(true);
+    glState.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+const SpriteBatchStats& SceneRenderer2D::GetSpriteBatchStats() const {
+    if (spriteRenderPath == SpriteRenderPath::INSTANCED) {
+        return spriteInstancer.GetStats();
+    }
+    return spriteBatch.GetStats();
 }
 
 GLuint SceneRenderer2D::GetViewportTextureID() const {
-    return textureID;
+    return renderTarget ? renderTarget->colorTexture : 0;
 }
 
-GLuint SceneRenderer2D::LoadShaderFromFile(const std::string& path, GLenum type) {
-    cout << "Loading shader from file: " << path << endl;
-    
-    // Open and read the shader file
-    std::ifstream file(path.c_str());
-    if (!file.is_open()) {
-        std::cerr << "Failed to open shader file: " << path << std::endl;
-        return 0;
+glm::vec2 SceneRenderer2D::GetViewportUV() const {
+    if (!renderTarget) return glm::vec2(1.0f);
+    return glm::vec2((float)width / renderTarget->allocatedWidth, (float)height / renderTarget->allocatedHeight);
+}
+
+void SceneRenderer2D::RequestViewportCapture(int maxWidth, int maxHeight, ReadbackCallback callback) {
+    PendingCapture capture;
+    capture.maxWidth = maxWidth;
+    capture.maxHeight = maxHeight;
+    capture.callback = move(callback);
+    pendingCaptures.push_back(move(capture));
+}
+
+void SceneRenderer2D::ProcessReadbacks() {
+    readbackService.Poll();
+    if (pendingCaptures.empty()) return;
+    // Belum ada frame lengkap (baru resize atau overflow): render dulu, capture di frame berikutnya
+    if (!viewportValid || !renderTarget) {
+        redrawRequested = true;
+        return;
     }
-    
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string source = buffer.str();
-    const char* src = source.c_str();
-    Debug::Logger::Log("Shader Source: \n" + source, Debug::LogLevel::WARNING);
-    // Create and compile the shader
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &src, nullptr);
-    glCompileShader(shader);
-    
-    // Check for compilation errors
-    GLint compiled;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
-    if (!compiled) {
-        char log[512];
-        glGetShaderInfoLog(shader, 512, nullptr, log);
-        std::cerr << "Shader compile error (" << path << "): " << log << std::endl;
-        glDeleteShader(shader);
-        return 0;
+
+    // Downscale dan read dideklarasikan di frame graph: setiap langkah setengah ukuran adalah target
+    // transient, jadi langkah ketiga memakai ulang memori langkah pertama dan seterusnya
+    frameGraph.Reset();
+    FrameGraphResource viewport = frameGraph.ImportTarget("Viewport", renderTarget, width, height);
+    size_t issued = 0;
+    uint32_t freeSlots = ReadbackService::SlotCount - readbackService.GetInFlight();
+    for (PendingCapture& capture : pendingCaptures) {
+        if (issued == freeSlots) break;
+        AddCapturePasses(viewport, capture);
+        issued++;
     }
-    
-    return shader;
+    pendingCaptures.erase(pendingCaptures.begin(), pendingCaptures.begin() + issued);
+
+    // Blit terkena scissor, ImGui bisa meninggalkannya aktif di luar frame
+    GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+    if (scissor) glDisable(GL_SCISSOR_TEST);
+    frameGraph.Execute();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    if (scissor) glEnable(GL_SCISSOR_TEST);
+}
+
+void SceneRenderer2D::AddCapturePasses(FrameGraphResource viewport, PendingCapture& capture) {
+    // Skala terkecil dari kedua batas, tidak pernah diperbesar
+    float scale = 1.0f;
+    if (capture.maxWidth > 0) scale = min(scale, float(capture.maxWidth) / width);
+    if (capture.maxHeight > 0) scale = min(scale, float(capture.maxHeight) / height);
+    int outWidth = max(1, int(width * scale + 0.5f));
+    int outHeight = max(1, int(height * scale + 0.5f));
+
+    // Blit linear paling banyak 2x per langkah, setiap pixel tujuan = rata-rata 2x2 sumber
+    FrameGraphResource source = viewport;
+    int sourceWidth = width, sourceHeight = height;
+    while (sourceWidth != outWidth || sourceHeight != outHeight) {
+        bool last = sourceWidth <= outWidth * 2 && sourceHeight <= outHeight * 2;
+        int nextWidth = last ? outWidth : max(outWidth, sourceWidth / 2);
+        int nextHeight = last ? outHeight : max(outHeight, sourceHeight / 2);
+        FrameGraphResource next = frameGraph.CreateTarget("CaptureDownscale", nextWidth, nextHeight);
+        FrameGraphPass pass = frameGraph.AddPass("CaptureDownscale", [source, next](const FrameGraph& graph) {
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, graph.GetTarget(source)->framebuffer);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, graph.GetTarget(next)->framebuffer);
+            glBlitFramebuffer(0, 0, graph.GetWidth(source), graph.GetHeight(source),
+                              0, 0, graph.GetWidth(next), graph.GetHeight(next), GL_COLOR_BUFFER_BIT, GL_LINEAR);
+        });
+        frameGraph.Read(pass, source);
+        frameGraph.Write(pass, next);
+        source = next;
+        sourceWidth = nextWidth;
+        sourceHeight = nextHeight;
+    }
+
+    ReadbackCallback callback = move(capture.callback);
+    FrameGraphPass read = frameGraph.AddPass("CaptureRead", [this, source, callback](const FrameGraph& graph) {
+        readbackService.Request(graph.GetTarget(source)->framebuffer, 0, 0,
+                                graph.GetWidth(source), graph.GetHeight(source), callback);
+    });
+    frameGraph.Read(read, source);
+    frameGraph.SetSideEffect(read);
 }
 
 void SceneRenderer2D::InitGridBuffers() {
@@ -650,45 +1007,6 @@ void SceneRenderer2D::InitGridBuffers() {
     cout << m_GridVAO << " " << m_GridVBO << " " << m_MaxGridLines << endl;
 }
 
-GLuint SceneRenderer2D::CreateShaderProgram(const std::string& vertPath, const std::string& fragPath) {
-    cout << "Creating shader program from: " << vertPath << " and " << fragPath << endl;
-    
-    // Load and compile the vertex and fragment shaders
-    GLuint vertShader = LoadShaderFromFile(vertPath, GL_VERTEX_SHADER);
-    if (vertShader == 0) return 0;
-    
-    GLuint fragShader = LoadShaderFromFile(fragPath, GL_FRAGMENT_SHADER);
-    if (fragShader == 0) {
-        glDeleteShader(vertShader);
-        return 0;
-    }
-    
-    // Create and link the shader program
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertShader);
-    glAttachShader(program, fragShader);
-    glLinkProgram(program);
-    
-    // Check for linking errors
-    // GLint linked;
-    // glGetProgramiv(program, GL_LINK_STATUS, &linked);
-    // if (!linked) {
-    //     char log[512];
-    //     glGetProgramInfoLog(program, 512, nullptr, log);
-    //     std::cerr << "Shader linking error: " << log << std::endl;
-    //     glDeleteShader(vertShader);
-    //     glDeleteShader(fragShader);
-    //     glDeleteProgram(program);
-    //     return 0;
-    // }
-    
-    // Once linked, the shader objects can be deleted
-    glDeleteShader(vertShader);
-    glDeleteShader(fragShader);
-    Debug::Logger::Log("[Debug] Shader Program Successfully Created: " + std::to_string(program), Debug::LogLevel::SUCCESS);
-    return program;
-}
-
 GLuint SceneRenderer2D::CreateWhiteTexture() {
     unsigned char whitePixel[] = { 255, 255, 255, 255 };
     GLuint tex;
@@ -704,7 +1022,7 @@ GLuint SceneRenderer2D::CreateWhiteTexture() {
 void SceneRenderer2D::SetEditMode(EditMode mode) {
     currentMode = mode;
     // Reset selected if switching to SELECT mode
-    if (mode == EditMode::SELECT && selectedObject != nullptr) {
+    if (mode == EditMode::SELECT && GetSelectedObject() != nullptr) {
         // Optionally deselect current object
     }
 }
@@ -754,30 +1072,103 @@ glm::vec2 SceneRenderer2D::WorldToViewportPosition(float worldX, float worldY) c
 }
 
 void SceneRenderer2D::HandleClick(float worldX, float worldY) {
-    // Reset selection
-    selectedObject = nullptr;
+    if (pickingEnabled) {
+        // Sama dengan ortho box RenderSceneToTexture: pusat viewport = posisi kamera.
+        // Selection diganti saat hasil read attachment ID datang.
+        RequestPick(static_cast<int>(floor((worldX - cameraPosition.x) * cameraZoom + width * 0.5f)),
+                    static_cast<int>(floor((worldY - cameraPosition.y) * cameraZoom + height * 0.5f)),
+                    PickPurpose::SELECT);
+        return;
+    }
+    SelectObject(PickObjectOnCpu(worldX, worldY));
+}
+
+int SceneRenderer2D::PickObjectOnCpu(float worldX, float worldY) const {
+    const std::vector<GameObject>& objects = editScene->objects;
+    int best = -1;
+    for (int i = 0; i < (int)objects.size(); i++) {
+        const GameObject& obj = objects[i];
+        float w = obj.width * obj.scaleX;
+        float h = obj.height * obj.scaleY;
+
+        // Titik klik diputar balik ke ruang lokal sprite, rotasi di sekitar titik tengah
+        float angle = -glm::radians(obj.rotation);
+        float dx = worldX - (obj.x + w * 0.5f);
+        float dy = worldY - (obj.y + h * 0.5f);
+        float localX = dx * cos(angle) - dy * sin(angle);
+        float localY = dx * sin(angle) + dy * cos(angle);
+        if (fabs(localX) > fabs(w) * 0.5f || fabs(localY) > fabs(h) * 0.5f) continue;
+
+        // Paling atas menurut urutan render: layer, lalu depth, lalu urutan di scene
+        const GameObject* top = best >= 0 ? &objects[best] : nullptr;
+        if (!top || obj.layer > top->layer || (obj.layer == top->layer && obj.depth >= top->depth)) best = i;
+    }
+    return best;
+}
+
+void SceneRenderer2D::SelectObject(int index) {
     selectedObjectIndex = -1;
-    
-    // Find clicked object (in reverse order to select topmost object)
-    for (int i = currentScene.objects.size() - 1; i >= 0; i--) {
-        GameObject& obj = currentScene.objects[i];
-        
-        // Check if click is within object bounds
-        if (worldX >= obj.x && worldX <= obj.x + obj.width * obj.scaleX &&
-            worldY >= obj.y && worldY <= obj.y + obj.height * obj.scaleY) {
-            selectedObject = &obj;
-            selectedObjectIndex = i;
-            
-            // You could potentially add a callback for selection change
-            break;
-        }
+    if (index >= 0 && index < (int)editScene->objects.size()) selectedObjectIndex = index;
+}
+
+void SceneRenderer2D::SetEditScene(Scene* scene) {
+    if (!scene) scene = &currentScene;
+    editScene = scene;
+    SyncEditScene();
+}
+
+void SceneRenderer2D::SyncEditScene() {
+    // Pointer scene yang sama bisa berisi scene lain setelah load (Scene di-assign), dicek lewat id
+    if (editScene->id == editSceneId) return;
+    editSceneId = editScene->id;
+    // Index selection dan pick yang masih jalan milik scene lama
+    SelectObject(-1);
+    hoveredObjectIndex = -1;
+    objectPicker.Reset();
+    redrawRequested = true;
+}
+
+void SceneRenderer2D::SetPickingEnabled(bool enabled) {
+    if (pickingEnabled == enabled) return;
+    pickingEnabled = enabled;
+    // Attachment ID baru diisi di frame berikutnya
+    redrawRequested = true;
+    if (!enabled) {
+        objectPicker.Reset();
+        hoveredObjectIndex = -1;
     }
 }
 
+void SceneRenderer2D::RequestPick(int x, int y, PickPurpose purpose) {
+    if (!pickingEnabled) return;
+    objectPicker.Request(x, y, purpose);
+}
+
+void SceneRenderer2D::ProcessPicks() {
+    pickResults.clear();
+    objectPicker.Poll(renderQueue, pickResults);
+    for (const PickResult& result : pickResults) {
+        if (result.purpose == PickPurpose::HOVER) hoveredObjectIndex = result.objectIndex;
+        else SelectObject(result.objectIndex);
+    }
+
+    if (!objectPicker.HasQueued()) return;
+    // Attachment ID dari frame terakhir masih sesuai dengan yang tampil di layar
+    if (pickBufferValid && renderTarget) objectPicker.Issue(renderTarget->framebuffer, width, height, renderQueue);
+    else if (pickingEnabled) redrawRequested = true;
+}
+
+void SceneRenderer2D::SetPickOutput(bool enabled) {
+    // Shader pass lain tidak menulis location 1, isi attachment ID akan rusak kalau tetap aktif
+    GLenum drawBuffers[] = { GL_COLOR_ATTACHMENT0, GLenum(enabled ? GL_COLOR_ATTACHMENT1 : GL_NONE) };
+    glDrawBuffers(2, drawBuffers);
+}
+
 void SceneRenderer2D::HandleDrag(float deltaX, float deltaY) {
     // Scale delta by zoom factor for consistent movement
     float scaledDeltaX = deltaX / cameraZoom;
     float scaledDeltaY = deltaY / cameraZoom;
+    GameObject* selectedObject = GetSelectedObject();
     
     if (selectedObject != nullptr && currentMode == EditMode::MOVE) {
         // Move selected object
@@ -789,6 +1180,7 @@ void SceneRenderer2D::HandleDrag(float deltaX, float deltaY) {
             selectedObject->x = round(selectedObject->x / gridSize) * gridSize;
             selectedObject->y = round(selectedObject->y / gridSize) * gridSize;
         }
+        editScene->MarkDirty();
     }
     else if (selectedObject != nullptr && currentMode == EditMode::ROTATE) {
         // Calculate rotation based on drag distance
@@ -798,11 +1190,13 @@ void SceneRenderer2D::HandleDrag(float deltaX, float deltaY) {
         // Normalize rotation to 0-360 degrees
         while (selectedObject->rotation >= 360.0f) selectedObject->rotation -= 360.0f;
         while (selectedObject->rotation < 0.0f) selectedObject->rotation += 360.0f;
+        editScene->MarkDirty();
     }
     else if (selectedObject != nullptr && currentMode == EditMode::SCALE) {
         // Scale object based on drag
         selectedObject->scaleX = std::max(0.1f, selectedObject->scaleX + scaledDeltaX * 0.01f);
         selectedObject->scaleY = std::max(0.1f, selectedObject->scaleY + scaledDeltaY * 0.01f);
+        editScene->MarkDirty();
     }
     else {
         // If no object selected or in SELECT mode, pan the camera
@@ -821,6 +1215,7 @@ void SceneRenderer2D::HandleZoom(float delta) {
 }
 
 void SceneRenderer2D::MoveSelected(float deltaX, float deltaY) {
+    GameObject* selectedObject = GetSelectedObject();
     if (selectedObject) {
         selectedObject->x += deltaX;
         selectedObject->y += deltaY;
@@ -830,17 +1225,18 @@ void SceneRenderer2D::MoveSelected(float deltaX, float deltaY) {
             selectedObject->x = round(selectedObject->x / gridSize) * gridSize;
             selectedObject->y = round(selectedObject->y / gridSize) * gridSize;
         }
+        editScene->MarkDirty();
     }
 }
 
 void SceneRenderer2D::DeleteSelected() {
-    if (selectedObjectIndex >= 0 && selectedObjectIndex < currentScene.objects.size()) {
-        currentScene.objects.erase(currentScene.objects.begin() + selectedObjectIndex);
-        selectedObject = nullptr;
+    if (GetSelectedObject()) {
+        editScene->objects.erase(editScene->objects.begin() + selectedObjectIndex);
+        editScene->MarkDirty();
         selectedObjectIndex = -1;
     }
 }
 
 bool SceneRenderer2D::HasSelectedObject() const {
-    return selectedObject != nullptr;
+    return GetSelectedObject() != nullptr;
 }
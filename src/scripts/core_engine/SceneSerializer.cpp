@@ -23,7 +23,60 @@ void SceneSerializer::SaveScene(const Scene& scene, const std::string& path) {
             {"spritePath", obj.spritePath},
             {"rotation", obj.rotation},
             {"scaleX", obj.scaleX},
-            {"scaleY", obj.scaleY}
+            {"scaleY", obj.scaleY},
+            {"layer", obj.layer},
+            {"depth", obj.depth}
+        });
+    }
+
+    for (const auto& tilemap : scene.tilemaps) {
+        // Tile disimpan run-length [jumlah, tile, jumlah, tile, ...], map besar biasanya banyak yang kosong
+        json runs = json::array();
+        const std::vector<uint16_t>& tiles = tilemap.GetTiles();
+        for (size_t i = 0; i < tiles.size();) {
+            size_t run = 1;
+            while (i + run < tiles.size() && tiles[i + run] == tiles[i]) run++;
+            runs.push_back(run);
+            runs.push_back(tiles[i]);
+            i += run;
+        }
+        j["tilemaps"].push_back({
+            {"name", tilemap.name},
+            {"x", tilemap.x},
+            {"y", tilemap.y},
+            {"tileSize", tilemap.tileSize},
+            {"width", tilemap.GetWidth()},
+            {"height", tilemap.GetHeight()},
+            {"tilesetPath", tilemap.tilesetPath},
+            {"tilesetColumns", tilemap.tilesetColumns},
+            {"tilesetRows", tilemap.tilesetRows},
+            {"layer", tilemap.layer},
+            {"depth", tilemap.depth},
+            {"tiles", runs}
+        });
+    }
+
+    for (const auto& emitter : scene.emitters) {
+        j["emitters"].push_back({
+            {"name", emitter.name},
+            {"x", emitter.x},
+            {"y", emitter.y},
+            {"texturePath", emitter.texturePath},
+            {"additive", emitter.additive},
+            {"emitting", emitter.emitting},
+            {"maxParticles", emitter.maxParticles},
+            {"rate", emitter.rate},
+            {"lifetime", {emitter.lifetimeMin, emitter.lifetimeMax}},
+            {"speed", {emitter.speedMin, emitter.speedMax}},
+            {"direction", emitter.direction},
+            {"spread", emitter.spread},
+            {"gravity", {emitter.gravityX, emitter.gravityY}},
+            {"drag", emitter.drag},
+            {"size", {emitter.startSize, emitter.endSize}},
+            {"startColor", emitter.startColor},
+            {"endColor", emitter.endColor},
+            {"layer", emitter.layer},
+            {"depth", emitter.depth}
         });
     }
 
@@ -88,6 +141,8 @@ Scene SceneSerializer::LoadScene(const std::string& path) {
             obj.rotation = jObj.value("rotation", 0.0f);
             obj.scaleX = jObj.value("scaleX", 1.0f);
             obj.scaleY = jObj.value("scaleY", 1.0f);
+            obj.layer = jObj.value("layer", 0);
+            obj.depth = jObj.value("depth", 0.0f);
             
             scene.objects.push_back(obj);
             
@@ -97,7 +152,79 @@ Scene SceneSerializer::LoadScene(const std::string& path) {
                       << ", Sprite: " << obj.spritePath << ")" << std::endl;
         }
         
-        std::cout << "Scene loaded successfully with " << scene.objects.size() << " objects" << std::endl;
+        if (j.contains("tilemaps")) {
+            for (const auto& jMap : j["tilemaps"]) {
+                Tilemap tilemap;
+                tilemap.name = jMap.value("name", "");
+                tilemap.x = jMap.value("x", 0.0f);
+                tilemap.y = jMap.value("y", 0.0f);
+                tilemap.tileSize = jMap.value("tileSize", 32.0f);
+                tilemap.tilesetPath = jMap.value("tilesetPath", "");
+                std::replace(tilemap.tilesetPath.begin(), tilemap.tilesetPath.end(), '\\', '/');
+                tilemap.tilesetColumns = std::max(1, jMap.value("tilesetColumns", 1));
+                tilemap.tilesetRows = std::max(1, jMap.value("tilesetRows", 1));
+                tilemap.layer = jMap.value("layer", 0);
+                tilemap.depth = jMap.value("depth", 0.0f);
+                tilemap.Resize(jMap.value("width", 0), jMap.value("height", 0));
+
+                // Run-length [jumlah, tile, ...], sisa yang tidak tercakup tetap kosong
+                int width = tilemap.GetWidth();
+                size_t total = size_t(width) * tilemap.GetHeight();
+                size_t index = 0;
+                auto runs = jMap.find("tiles");
+                for (size_t r = 0; runs != jMap.end() && r + 1 < runs->size() && index < total; r += 2) {
+                    size_t count = std::min<size_t>((*runs)[r].get<size_t>(), total - index);
+                    uint16_t tile = (*runs)[r + 1].get<uint16_t>();
+                    for (size_t k = 0; k < count; k++, index++) {
+                        if (tile) tilemap.SetTile(int(index % width), int(index / width), tile);
+                    }
+                }
+                scene.tilemaps.push_back(std::move(tilemap));
+            }
+        }
+
+        if (j.contains("emitters")) {
+            // Pasangan [min, max] atau [x, y], nilai default dipakai kalau field tidak ada
+            auto readPair = [](const json& jEmitter, const char* key, float& first, float& second) {
+                auto it = jEmitter.find(key);
+                if (it == jEmitter.end() || !it->is_array() || it->size() < 2) return;
+                first = (*it)[0].get<float>();
+                second = (*it)[1].get<float>();
+            };
+            auto readColor = [](const json& jEmitter, const char* key, float* color) {
+                auto it = jEmitter.find(key);
+                if (it == jEmitter.end() || !it->is_array()) return;
+                for (size_t c = 0; c < 4 && c < it->size(); c++) color[c] = (*it)[c].get<float>();
+            };
+
+            for (const auto& jEmitter : j["emitters"]) {
+                ParticleEmitter emitter;
+                emitter.name = jEmitter.value("name", "");
+                emitter.x = jEmitter.value("x", 0.0f);
+                emitter.y = jEmitter.value("y", 0.0f);
+                emitter.texturePath = jEmitter.value("texturePath", "");
+                std::replace(emitter.texturePath.begin(), emitter.texturePath.end(), '\\', '/');
+                emitter.additive = jEmitter.value("additive", false);
+                emitter.emitting = jEmitter.value("emitting", true);
+                emitter.maxParticles = jEmitter.value("maxParticles", 10000u);
+                emitter.rate = jEmitter.value("rate", 500.0f);
+                readPair(jEmitter, "lifetime", emitter.lifetimeMin, emitter.lifetimeMax);
+                readPair(jEmitter, "speed", emitter.speedMin, emitter.speedMax);
+                emitter.direction = jEmitter.value("direction", 90.0f);
+                emitter.spread = jEmitter.value("spread", 30.0f);
+                readPair(jEmitter, "gravity", emitter.gravityX, emitter.gravityY);
+                emitter.drag = jEmitter.value("drag", 0.0f);
+                readPair(jEmitter, "size", emitter.startSize, emitter.endSize);
+                readColor(jEmitter, "startColor", emitter.startColor);
+                readColor(jEmitter, "endColor", emitter.endColor);
+                emitter.layer = jEmitter.value("layer", 0);
+                emitter.depth = jEmitter.value("depth", 0.0f);
+                scene.emitters.push_back(emitter);
+            }
+        }
+        
+        std::cout << "Scene loaded successfully with " << scene.objects.size() << " objects, "
+                  << scene.tilemaps.size() << " tilemaps and " << scene.emitters.size() << " emitters" << std::endl;
     } 
     catch (const json::exception& e) {
         std::cerr << "JSON parsing error: " << e.what() << std::endl;
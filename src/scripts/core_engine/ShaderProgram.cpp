@@ -0,0 +1,238 @@
+#include <ShaderProgram.hpp>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+#include <Debugger.hpp>
+
+using namespace std;
+
+ShaderProgram::~ShaderProgram() {
+    Destroy();
+}
+
+void ShaderProgram::Destroy() {
+    if (program) {
+        glDeleteProgram(program);
+        program = 0;
+    }
+    uniforms.clear();
+}
+
+GLuint ShaderProgram::CompileShader(const std::string& path, GLenum type) {
+    cout << "Loading shader from file: " << path << endl;
+
+    std::ifstream file(path.c_str());
+    if (!file.is_open()) {
+        std::cerr << "Failed to open shader file: " << path << std::endl;
+        return 0;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string source = buffer.str();
+    const char* src = source.c_str();
+
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &src, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[512];
+        glGetShaderInfoLog(shader, 512, nullptr, log);
+        std::cerr << "Shader compile error (" << path << "): " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+bool ShaderProgram::LoadFromFiles(const std::string& vertPath, const std::string& fragPath) {
+    Destroy();
+    cout << "Creating shader program from: " << vertPath << " and " << fragPath << endl;
+
+    GLuint vertShader = CompileShader(vertPath, GL_VERTEX_SHADER);
+    if (vertShader == 0) return false;
+
+    GLuint fragShader = CompileShader(fragPath, GL_FRAGMENT_SHADER);
+    if (fragShader == 0) {
+        glDeleteShader(vertShader);
+        return false;
+    }
+
+    program = glCreateProgram();
+    glAttachShader(program, vertShader);
+    glAttachShader(program, fragShader);
+    glLinkProgram(program);
+
+    // Once linked, the shader objects can be deleted
+    glDeleteShader(vertShader);
+    glDeleteShader(fragShader);
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        GLchar infoLog[1024];
+        glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+        std::cerr << "ERROR::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        glDeleteProgram(program);
+        program = 0;
+        return false;
+    }
+
+    Reflect();
+    Debug::Logger::Log("[ShaderProgram] Program " + std::to_string(program) + " linked with " +
+                       std::to_string(uniforms.size()) + " uniforms", Debug::LogLevel::SUCCESS);
+    return true;
+}
+
+void ShaderProgram::Reflect() {
+    uniforms.clear();
+
+    GLint count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (GLint i = 0; i < count; i++) {
+        GLchar name[128];
+        GLsizei length = 0;
+        UniformInfo info;
+        glGetActiveUniform(program, (GLuint)i, sizeof(name), &length, &info.size, &info.type, name);
+
+        // Uniform di dalam block tidak punya location, diatur lewat UBO
+        info.location = glGetUniformLocation(program, name);
+        if (info.location == -1) continue;
+
+        info.name.assign(name, length);
+        size_t bracket = info.name.find('[');
+        if (bracket != std::string::npos) info.name.resize(bracket);
+        uniforms.push_back(info);
+    }
+}
+
+ShaderProgram::UniformInfo* ShaderProgram::FindUniform(const char* name) {
+    for (auto& uniform : uniforms) {
+        if (uniform.name == name) return &uniform;
+    }
+    return nullptr;
+}
+
+const ShaderProgram::UniformInfo* ShaderProgram::FindUniform(const char* name) const {
+    for (const auto& uniform : uniforms) {
+        if (uniform.name == name) return &uniform;
+    }
+    return nullptr;
+}
+
+GLint ShaderProgram::GetUniformLocation(const char* name) const {
+    const UniformInfo* uniform = FindUniform(name);
+    return uniform ? uniform->location : -1;
+}
+
+bool ShaderProgram::RequireUniforms(const std::vector<std::pair<const char*, GLenum>>& required) const {
+    bool allValid = true;
+    for (const auto& [name, type] : required) {
+        const UniformInfo* uniform = FindUniform(name);
+        if (!uniform) {
+            Debug::Logger::Log("Uniform '" + std::string(name) + "' not found in shader program " + std::to_string(program), Debug::LogLevel::CRASH);
+            allValid = false;
+        } else if (uniform->type != type) {
+            Debug::Logger::Log("Uniform '" + std::string(name) + "' has unexpected type in shader program " + std::to_string(program), Debug::LogLevel::CRASH);
+            allValid = false;
+        }
+    }
+    return allValid;
+}
+
+bool ShaderProgram::BindUniformBlock(const char* blockName, GLuint bindingPoint) {
+    GLuint index = glGetUniformBlockIndex(program, blockName);
+    if (index == GL_INVALID_INDEX) {
+        Debug::Logger::Log("Uniform block '" + std::string(blockName) + "' not found in shader program " + std::to_string(program), Debug::LogLevel::WARNING);
+        return false;
+    }
+    glUniformBlockBinding(program, index, bindingPoint);
+    return true;
+}
+
+bool ShaderProgram::CacheValue(UniformInfo& uniform, const float* data, int count) {
+    if (uniform.hasValue && std::memcmp(uniform.value, data, count * sizeof(float)) == 0) {
+        skippedUploads++;
+        return false;
+    }
+    std::memcpy(uniform.value, data, count * sizeof(float));
+    uniform.hasValue = true;
+    return true;
+}
+
+void ShaderProgram::SetInt(const char* name, int value) {
+    UniformInfo* uniform = FindUniform(name);
+    if (!uniform) return;
+    float bits;
+    std::memcpy(&bits, &value, sizeof(int));
+    if (CacheValue(*uniform, &bits, 1)) glUniform1i(uniform->location, value);
+}
+
+void ShaderProgram::SetFloat(const char* name, float value) {
+    UniformInfo* uniform = FindUniform(name);
+    if (uniform && CacheValue(*uniform, &value, 1)) glUniform1f(uniform->location, value);
+}
+
+void ShaderProgram::SetVec2(const char* name, const glm::vec2& value) {
+    UniformInfo* uniform = FindUniform(name);
+    if (uniform && CacheValue(*uniform, glm::value_ptr(value), 2)) glUniform2fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::SetVec3(const char* name, const glm::vec3& value) {
+    UniformInfo* uniform = FindUniform(name);
+    if (uniform && CacheValue(*uniform, glm::value_ptr(value), 3)) glUniform3fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::SetVec4(const char* name, const glm::vec4& value) {
+    UniformInfo* uniform = FindUniform(name);
+    if (uniform && CacheValue(*uniform, glm::value_ptr(value), 4)) glUniform4fv(uniform->location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::SetMat4(const char* name, const glm::mat4& value) {
+    UniformInfo* uniform = FindUniform(name);
+    if (uniform && CacheValue(*uniform, glm::value_ptr(value), 16)) glUniformMatrix4fv(uniform->location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+CameraUniformBuffer::~CameraUniformBuffer() {
+    Shutdown();
+}
+
+void CameraUniformBuffer::Init() {
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraUniforms), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, BindingPoint, ubo);
+    hasData = false;
+}
+
+void CameraUniformBuffer::Shutdown() {
+    if (ubo) {
+        glDeleteBuffers(1, &ubo);
+        ubo = 0;
+    }
+    hasData = false;
+}
+
+void CameraUniformBuffer::Update(const glm::mat4& projection, const glm::mat4& view, float width, float height, float zoom) {
+    CameraUniforms next;
+    next.projection = projection;
+    next.view = view;
+    next.viewport = glm::vec4(width, height, zoom, 0.0f);
+
+    // Binding bisa diubah pihak lain (mis. ImGui), pastikan tetap di binding point kita
+    glBindBufferBase(GL_UNIFORM_BUFFER, BindingPoint, ubo);
+    if (hasData && std::memcmp(&next, &current, sizeof(CameraUniforms)) == 0) return;
+
+    current = next;
+    hasData = true;
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CameraUniforms), &current);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
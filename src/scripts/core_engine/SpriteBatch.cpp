@@ -0,0 +1,199 @@
+#include <SpriteBatch.hpp>
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <glm/gtc/type_ptr.hpp>
+#include <Debugger.hpp>
+
+using namespace std;
+
+SpriteBatch::~SpriteBatch() {
+    Shutdown();
+}
+
+void SpriteBatch::Init(GLStateCache& stateCache, StreamBuffer& streamBuffer) {
+    state = &stateCache;
+    stream = &streamBuffer;
+    vertices.reserve(MaxSprites * 4);
+
+    // Index buffer statis, urutan quad selalu sama jadi cukup dibuat sekali
+    std::vector<GLuint> indices(MaxSprites * 6);
+    for (GLuint i = 0, v = 0; i < MaxSprites * 6; i += 6, v += 4) {
+        indices[i + 0] = v + 0;
+        indices[i + 1] = v + 1;
+        indices[i + 2] = v + 2;
+        indices[i + 3] = v + 0;
+        indices[i + 4] = v + 2;
+        indices[i + 5] = v + 3;
+    }
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &ebo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+    // Position (vec3) dan texture coordinate (vec2), pointer-nya diatur per flush ke offset di StreamBuffer
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+    Debug::Logger::Log("[SpriteBatch] Initialized with capacity " + std::to_string(MaxSprites) + " sprites per flush", Debug::LogLevel::SUCCESS);
+}
+
+void SpriteBatch::Shutdown() {
+    if (ebo) { glDeleteBuffers(1, &ebo); ebo = 0; }
+    if (vao) {
+        if (state) state->ForgetVertexArray(vao);
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+}
+
+void SpriteBatch::Begin(ShaderProgram& program) {
+    if (inBatch) End();
+
+    inBatch = true;
+    currentProgram = &program;
+    currentTexture = 0;
+    vertices.clear();
+
+    program.Use(*state);
+    program.SetInt("u_Texture", 0);
+}
+
+void SpriteBatch::Submit(GLuint texture, float x, float y, float width, float height,
+                         float rotation, float scaleX, float scaleY, const glm::vec4& uvRect) {
+    if (!inBatch || texture == 0) return;
+
+    // Ganti texture atau buffer penuh = akhir dari satu run
+    if (texture != currentTexture || vertices.size() >= MaxSprites * 4) {
+        Flush();
+        currentTexture = texture;
+    }
+
+    size_t first = vertices.size();
+    vertices.resize(first + 4);
+    WriteQuad(&vertices[first], x, y, width, height, rotation, scaleX, scaleY, uvRect);
+    stats.spritesSubmitted++;
+}
+
+void SpriteBatch::WriteQuad(SpriteVertex* out, float x, float y, float width, float height,
+                            float rotation, float scaleX, float scaleY, const glm::vec4& uvRect,
+                            float depth) {
+    // Sama seperti gizmo/HandleClick: sprite menempati (x, y) sampai (x + w*sx, y + h*sy)
+    // dan diputar di sekitar titik tengahnya
+    float halfW = width * scaleX * 0.5f;
+    float halfH = height * scaleY * 0.5f;
+    float cx = x + halfW;
+    float cy = y + halfH;
+
+    float c = 1.0f, s = 0.0f;
+    if (rotation != 0.0f) {
+        float radians = glm::radians(rotation);
+        c = std::cos(radians);
+        s = std::sin(radians);
+    }
+
+    const float corners[4][2] = {
+        { -halfW, -halfH }, // bottom left
+        {  halfW, -halfH }, // bottom right
+        {  halfW,  halfH }, // top right
+        { -halfW,  halfH }  // top left
+    };
+    const float uvs[4][2] = {
+        { uvRect.x, uvRect.y },
+        { uvRect.z, uvRect.y },
+        { uvRect.z, uvRect.w },
+        { uvRect.x, uvRect.w }
+    };
+
+    for (int i = 0; i < 4; i++) {
+        out[i].x = cx + corners[i][0] * c - corners[i][1] * s;
+        out[i].y = cy + corners[i][0] * s + corners[i][1] * c;
+        out[i].z = depth;
+        out[i].u = uvs[i][0];
+        out[i].v = uvs[i][1];
+    }
+}
+
+SpriteVertex* SpriteBatch::BeginDirect(size_t spriteCount) {
+    if (inBatch) End();
+    directAllocation = StreamAllocation();
+    if (spriteCount == 0) return nullptr;
+
+    // Scene besar: region diperbesar sekarang, bukan frame berikutnya dengan pass sprite kosong
+    size_t bytes = spriteCount * 4 * sizeof(SpriteVertex);
+    if (!stream->Reserve(bytes, sizeof(SpriteVertex))) return nullptr;
+    directAllocation = stream->Allocate(bytes, sizeof(SpriteVertex));
+    if (!directAllocation.IsValid()) return nullptr;
+    return static_cast<SpriteVertex*>(directAllocation.data);
+}
+
+void SpriteBatch::DrawRuns(ShaderProgram& program, const vector<SpriteRun>& runs) {
+    if (!directAllocation.IsValid() || runs.empty()) return;
+    stream->Flush();
+
+    currentProgram = &program;
+    program.Use(*state);
+    program.SetInt("u_Texture", 0);
+
+    state->BindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->GetBuffer());
+    for (const SpriteRun& run : runs) {
+        state->BindTexture(0, run.texture);
+        // Index buffer hanya cukup untuk MaxSprites quad, run yang lebih panjang dipecah
+        for (uint32_t done = 0; done < run.count; done += MaxSprites) {
+            uint32_t count = std::min(MaxSprites, run.count - done);
+            GLintptr base = directAllocation.offset + GLintptr(run.first + done) * 4 * sizeof(SpriteVertex);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)(base + offsetof(SpriteVertex, x)));
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)(base + offsetof(SpriteVertex, u)));
+            // gl_VertexID mulai dari 0 per draw, ID picking butuh posisi sprite di allocation
+            program.SetInt("u_PickBase", static_cast<int>(run.first + done));
+            glDrawElements(GL_TRIANGLES, count * 6, GL_UNSIGNED_INT, 0);
+            stats.drawCalls++;
+        }
+        stats.spritesSubmitted += run.count;
+    }
+    stats.drawCallsSaved = stats.spritesSubmitted - stats.drawCalls;
+}
+
+void SpriteBatch::End() {
+    if (!inBatch) return;
+    Flush();
+    inBatch = false;
+}
+
+void SpriteBatch::Flush() {
+    if (vertices.empty() || currentTexture == 0) {
+        vertices.clear();
+        return;
+    }
+
+    GLsizei spriteCount = static_cast<GLsizei>(vertices.size() / 4);
+
+    // Region frame ini tidak dipakai GPU, tulis langsung tanpa orphaning
+    size_t bytes = vertices.size() * sizeof(SpriteVertex);
+    StreamAllocation allocation = stream->Allocate(bytes, sizeof(SpriteVertex));
+    if (!allocation.IsValid()) {
+        vertices.clear();
+        return;
+    }
+    memcpy(allocation.data, vertices.data(), bytes);
+    stream->Flush();
+
+    state->BindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->GetBuffer());
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)(allocation.offset + offsetof(SpriteVertex, x)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)(allocation.offset + offsetof(SpriteVertex, u)));
+
+    state->BindTexture(0, currentTexture);
+    glDrawElements(GL_TRIANGLES, spriteCount * 6, GL_UNSIGNED_INT, 0);
+
+    stats.drawCalls++;
+    stats.drawCallsSaved = stats.spritesSubmitted - stats.drawCalls;
+    vertices.clear();
+}
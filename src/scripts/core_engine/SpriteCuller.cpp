@@ -0,0 +1,148 @@
+#include <SpriteCuller.hpp>
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPRITE_CULLER_SSE2 1
+#else
+#define SPRITE_CULLER_SSE2 0
+#endif
+
+using namespace std;
+
+static float ElapsedMs(chrono::steady_clock::time_point start) {
+    return chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void SpriteCuller::Cull(const vector<GameObject>& objects, uint64_t sceneRevision, float camMinX, float camMinY, float camMaxX, float camMaxY,
+                        WorkerPool* pool) {
+    size_t count = objects.size();
+    // Dibulatkan ke kelipatan 4, slot sisa diisi box kosong yang selalu gagal tes
+    size_t padded = (count + 3) & ~size_t(3);
+    size_t chunks = pool ? pool->ChunkCount(padded, MinChunkSize, 4) : min<size_t>(padded, 1);
+
+    auto start = chrono::steady_clock::now();
+    // Object tidak berubah (misalnya hanya kamera yang bergerak), bounds lama masih valid
+    if (sceneRevision != boundsRevision || count != boundsCount) {
+        minX.resize(padded);
+        minY.resize(padded);
+        maxX.resize(padded);
+        maxY.resize(padded);
+
+        const float inf = numeric_limits<float>::infinity();
+        for (size_t i = count; i < padded; i++) {
+            minX[i] = minY[i] = inf;
+            maxX[i] = maxY[i] = -inf;
+        }
+
+        if (pool) {
+            pool->ParallelFor(padded, MinChunkSize, [&](size_t, size_t begin, size_t end) {
+                BuildBounds(objects, begin, min(end, count));
+            }, 4);
+        } else {
+            BuildBounds(objects, 0, count);
+        }
+        boundsRevision = sceneRevision;
+        boundsCount = count;
+    }
+    stats.boundsMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    if (chunkVisible.size() < chunks) chunkVisible.resize(chunks);
+    auto test = [&](size_t chunk, size_t begin, size_t end) {
+        vector<uint32_t>& out = chunkVisible[chunk];
+        out.clear();
+#if SPRITE_CULLER_SSE2
+        TestSIMD(out, begin, end, camMinX, camMinY, camMaxX, camMaxY);
+#else
+        TestScalar(out, begin, min(end, count), camMinX, camMinY, camMaxX, camMaxY);
+#endif
+    };
+    if (pool) {
+        pool->ParallelFor(padded, MinChunkSize, test, 4);
+    } else if (chunks) {
+        test(0, 0, padded);
+    }
+
+    // Chunk berurutan, jadi penggabungan dengan prefix sum tetap menghasilkan index naik
+    size_t total = 0;
+    for (size_t chunk = 0; chunk < chunks; chunk++) total += chunkVisible[chunk].size();
+    visible.resize(total);
+    size_t offset = 0;
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        const vector<uint32_t>& part = chunkVisible[chunk];
+        if (!part.empty()) memcpy(visible.data() + offset, part.data(), part.size() * sizeof(uint32_t));
+        offset += part.size();
+    }
+    stats.testMs = ElapsedMs(start);
+
+    stats.total = static_cast<uint32_t>(count);
+    stats.visible = static_cast<uint32_t>(visible.size());
+    stats.culled = stats.total - stats.visible;
+    stats.chunks = static_cast<uint32_t>(chunks);
+}
+
+void SpriteCuller::BuildBounds(const vector<GameObject>& objects, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        const GameObject& obj = objects[i];
+        // Sprite menempati (x, y) .. (x + w*sx, y + h*sy) dan berotasi di tengahnya
+        float halfW = fabsf(obj.width * obj.scaleX) * 0.5f;
+        float halfH = fabsf(obj.height * obj.scaleY) * 0.5f;
+        float centerX = obj.x + obj.width * obj.scaleX * 0.5f;
+        float centerY = obj.y + obj.height * obj.scaleY * 0.5f;
+
+        // Trigonometri hanya untuk object yang benar-benar dirotasi
+        float extentX = halfW, extentY = halfH;
+        if (obj.rotation != 0.0f) {
+            float radians = obj.rotation * 0.017453292519943295f;
+            float c = fabsf(cosf(radians));
+            float s = fabsf(sinf(radians));
+            extentX = halfW * c + halfH * s;
+            extentY = halfW * s + halfH * c;
+        }
+
+        minX[i] = centerX - extentX;
+        minY[i] = centerY - extentY;
+        maxX[i] = centerX + extentX;
+        maxY[i] = centerY + extentY;
+    }
+}
+
+void SpriteCuller::TestScalar(vector<uint32_t>& out, size_t begin, size_t end, float camMinX, float camMinY, float camMaxX, float camMaxY) const {
+    for (size_t i = begin; i < end; i++) {
+        if (maxX[i] >= camMinX && minX[i] <= camMaxX &&
+            maxY[i] >= camMinY && minY[i] <= camMaxY) {
+            out.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void SpriteCuller::TestSIMD(vector<uint32_t>& out, size_t begin, size_t end, float camMinX, float camMinY, float camMaxX, float camMaxY) const {
+#if SPRITE_CULLER_SSE2
+    const __m128 cMinX = _mm_set1_ps(camMinX);
+    const __m128 cMinY = _mm_set1_ps(camMinY);
+    const __m128 cMaxX = _mm_set1_ps(camMaxX);
+    const __m128 cMaxY = _mm_set1_ps(camMaxY);
+
+    for (size_t i = begin; i < end; i += 4) {
+        __m128 overlap = _mm_and_ps(
+            _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&maxX[i]), cMinX), _mm_cmple_ps(_mm_loadu_ps(&minX[i]), cMaxX)),
+            _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&maxY[i]), cMinY), _mm_cmple_ps(_mm_loadu_ps(&minY[i]), cMaxY)));
+
+        // Sebagian besar grup di scene besar gagal semua, cukup satu cek mask
+        int mask = _mm_movemask_ps(overlap);
+        if (mask == 0) continue;
+
+        uint32_t base = static_cast<uint32_t>(i);
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            if (mask & (1 << lane)) out.push_back(base + lane);
+        }
+    }
+#else
+    TestScalar(out, begin, end, camMinX, camMinY, camMaxX, camMaxY);
+#endif
+}
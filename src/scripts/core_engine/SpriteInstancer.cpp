@@ -0,0 +1,150 @@
+#include <SpriteInstancer.hpp>
+#include <iostream>
+#include <cstddef>
+#include <cstring>
+#include <glm/gtc/type_ptr.hpp>
+#include <Debugger.hpp>
+
+using namespace std;
+
+SpriteInstancer::~SpriteInstancer() {
+    Shutdown();
+}
+
+void SpriteInstancer::Init(GLStateCache& stateCache, StreamBuffer& streamBuffer) {
+    state = &stateCache;
+    stream = &streamBuffer;
+    // Unit quad (0..1), posisi dan ukuran sebenarnya datang dari instance
+    float corners[] = {
+        0.0f, 0.0f, // bottom left
+        1.0f, 0.0f, // bottom right
+        1.0f, 1.0f, // top right
+        0.0f, 1.0f  // top left
+    };
+    GLuint indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &quadVBO);
+    glGenBuffers(1, &quadEBO);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    // Atribut per-instance: rect (1), transform (2), uv rect (3), pointer diatur di End()
+    for (GLuint attrib = 1; attrib <= 3; attrib++) {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+
+    glBindVertexArray(0);
+    Debug::Logger::Log("[SpriteInstancer] Initialized instanced sprite path", Debug::LogLevel::SUCCESS);
+}
+
+void SpriteInstancer::Shutdown() {
+    if (quadEBO) { glDeleteBuffers(1, &quadEBO); quadEBO = 0; }
+    if (quadVBO) { glDeleteBuffers(1, &quadVBO); quadVBO = 0; }
+    if (vao) {
+        if (state) state->ForgetVertexArray(vao);
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+}
+
+void SpriteInstancer::SetInstanceAttributes(GLintptr baseOffset, uint32_t firstInstance) {
+    // Tanpa base instance (GL 4.2), offset run diatur lewat pointer atribut
+    size_t base = baseOffset + firstInstance * sizeof(SpriteInstance);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, x)));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, rotation)));
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(base + offsetof(SpriteInstance, u0)));
+}
+
+void SpriteInstancer::Begin(ShaderProgram& program) {
+    if (inBatch) End();
+
+    inBatch = true;
+    currentProgram = &program;
+    instances.clear();
+    runs.clear();
+
+    program.Use(*state);
+    program.SetInt("u_Texture", 0);
+}
+
+void SpriteInstancer::Submit(GLuint texture, float x, float y, float width, float height,
+                             float rotation, float scaleX, float scaleY, const glm::vec4& uvRect) {
+    if (!inBatch || texture == 0) return;
+
+    if (runs.empty() || runs.back().texture != texture) {
+        runs.push_back({ texture, static_cast<uint32_t>(instances.size()), 0 });
+    }
+    runs.back().count++;
+
+    instances.emplace_back();
+    WriteInstance(&instances.back(), x, y, width, height, rotation, scaleX, scaleY, uvRect);
+    stats.spritesSubmitted++;
+}
+
+void SpriteInstancer::End() {
+    if (!inBatch) return;
+    inBatch = false;
+    if (instances.empty()) return;
+
+    // Satu allocation untuk semua instance di frame ini
+    size_t bytes = instances.size() * sizeof(SpriteInstance);
+    StreamAllocation allocation = stream->Allocate(bytes, sizeof(SpriteInstance));
+    if (!allocation.IsValid()) return;
+    memcpy(allocation.data, instances.data(), bytes);
+    stream->Flush();
+
+    state->BindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->GetBuffer());
+
+    for (const SpriteRun& run : runs) {
+        SetInstanceAttributes(allocation.offset, run.first);
+        state->BindTexture(0, run.texture);
+        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, run.count);
+        stats.drawCalls++;
+    }
+    stats.drawCallsSaved = stats.spritesSubmitted - stats.drawCalls;
+}
+
+SpriteInstance* SpriteInstancer::BeginDirect(size_t spriteCount) {
+    if (inBatch) End();
+    directAllocation = StreamAllocation();
+    if (spriteCount == 0) return nullptr;
+
+    // Scene besar: region diperbesar sekarang, bukan frame berikutnya dengan pass sprite kosong
+    size_t bytes = spriteCount * sizeof(SpriteInstance);
+    if (!stream->Reserve(bytes, sizeof(SpriteInstance))) return nullptr;
+    directAllocation = stream->Allocate(bytes, sizeof(SpriteInstance));
+    if (!directAllocation.IsValid()) return nullptr;
+    return static_cast<SpriteInstance*>(directAllocation.data);
+}
+
+void SpriteInstancer::DrawRuns(ShaderProgram& program, const vector<SpriteRun>& drawRuns) {
+    if (!directAllocation.IsValid() || drawRuns.empty()) return;
+    stream->Flush();
+
+    currentProgram = &program;
+    program.Use(*state);
+    program.SetInt("u_Texture", 0);
+
+    state->BindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream->GetBuffer());
+    for (const SpriteRun& run : drawRuns) {
+        SetInstanceAttributes(directAllocation.offset, run.first);
+        // gl_InstanceID mulai dari 0 per draw, ID picking butuh posisi instance di allocation
+        program.SetInt("u_PickBase", static_cast<int>(run.first));
+        state->BindTexture(0, run.texture);
+        glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, run.count);
+        stats.drawCalls++;
+        stats.spritesSubmitted += run.count;
+    }
+    stats.drawCallsSaved = stats.spritesSubmitted - stats.drawCalls;
+}
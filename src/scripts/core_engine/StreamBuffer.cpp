@@ -0,0 +1,202 @@
+#include <StreamBuffer.hpp>
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <Debugger.hpp>
+
+using namespace std;
+
+StreamBuffer::~StreamBuffer() {
+    Shutdown();
+}
+
+bool StreamBuffer::Init(size_t size, bool allowPersistentMapping) {
+    Shutdown();
+    regionSize = size;
+    allowPersistent = allowPersistentMapping;
+    return CreateStorage();
+}
+
+void StreamBuffer::Shutdown() {
+    DestroyStorage();
+    staging.clear();
+    staging.shrink_to_fit();
+}
+
+bool StreamBuffer::CreateStorage() {
+    // glBufferStorage baru ada di GL 4.4, context 3.3 memakai staging + orphaning
+    persistent = allowPersistent && GLAD_GL_VERSION_4_4 && glBufferStorage != nullptr;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    if (persistent) {
+        GLsizeiptr totalSize = GLsizeiptr(regionSize) * RegionCount;
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, totalSize, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSize, flags));
+        if (!mapped) {
+            // Driver menolak mapping persisten, buat ulang buffer dengan jalur fallback
+            Debug::Logger::Log("[StreamBuffer] Persistent mapping failed, falling back to orphaning", Debug::LogLevel::WARNING);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+            allowPersistent = false;
+            return CreateStorage();
+        }
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+        staging.resize(regionSize);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    currentRegion = 0;
+    head = 0;
+    flushedHead = 0;
+    orphanedThisFrame = false;
+    Debug::Logger::Log("[StreamBuffer] " + string(persistent ? "Persistent-mapped " : "Orphaning ") +
+                       to_string(regionSize / 1024) + " KB x " + to_string(persistent ? RegionCount : 1) + " regions", Debug::LogLevel::SUCCESS);
+    return true;
+}
+
+void StreamBuffer::DestroyStorage() {
+    for (GLsync& fence : fences) {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if (buffer) {
+        if (mapped) {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    buffer = 0;
+    mapped = nullptr;
+}
+
+void StreamBuffer::WaitForRegion(int region) {
+    GLsync& fence = fences[region];
+    if (!fence) return;
+
+    // Biasanya sudah signaled karena region ini terakhir dipakai RegionCount frame lalu
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+        auto start = chrono::steady_clock::now();
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        } while (result == GL_TIMEOUT_EXPIRED);
+        stats.fenceWaits++;
+        stats.fenceWaitMs += chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void StreamBuffer::BeginFrame() {
+    if (!buffer) return;
+
+    // Statistik dihitung di thread GL, Allocate dari worker cukup menaikkan head
+    stats.bytesWritten += head.load(memory_order_relaxed);
+
+    // Frame lalu kehabisan tempat: perbesar region supaya frame berikutnya muat
+    if (overflowed) {
+        stats.overflows++;
+        if (regionSize < MaxRegionSize) Resize(min(regionSize * 2, MaxRegionSize));
+        overflowed = false;
+    }
+
+    if (persistent) {
+        currentRegion = (currentRegion + 1) % RegionCount;
+        WaitForRegion(currentRegion);
+    }
+    head = 0;
+    flushedHead = 0;
+    orphanedThisFrame = false;
+}
+
+void StreamBuffer::Resize(size_t newRegionSize) {
+    for (int i = 0; i < RegionCount; i++) WaitForRegion(i);
+    DestroyStorage();
+    regionSize = newRegionSize;
+    CreateStorage();
+    stats.resizes++;
+}
+
+bool StreamBuffer::Reserve(size_t bytes, size_t alignment) {
+    if (!buffer) return false;
+    // Padding alignment paling banyak alignment - 1 byte
+    alignment = max<size_t>(alignment, 1);
+    size_t required = head.load(memory_order_relaxed) + bytes + alignment - 1;
+    if (required <= regionSize) return true;
+
+    if (bytes + alignment - 1 > MaxRegionSize) {
+        Debug::Logger::Log("[StreamBuffer] Allocation of " + to_string(bytes / 1024) + " KB exceeds the maximum region size",
+                           Debug::LogLevel::WARNING);
+        overflowed = true;
+        return false;
+    }
+
+    // Region baru harus memuat isi frame sejauh ini plus allocation ini, supaya frame berikutnya
+    // tidak resize lagi. Tidak pernah dibuat ulang dengan ukuran yang sama.
+    size_t newRegionSize = regionSize;
+    while (newRegionSize < required && newRegionSize < MaxRegionSize) newRegionSize *= 2;
+    newRegionSize = min(newRegionSize, MaxRegionSize);
+    if (newRegionSize <= regionSize) {
+        // Sudah maksimum: allocation ini dilewati, frame berikutnya mulai dari head 0 lagi
+        overflowed = true;
+        return false;
+    }
+    Resize(newRegionSize);
+    return true;
+}
+
+void StreamBuffer::EndFrame() {
+    if (!buffer || !persistent) return;
+    if (fences[currentRegion]) glDeleteSync(fences[currentRegion]);
+    fences[currentRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+StreamAllocation StreamBuffer::Allocate(size_t bytes, size_t alignment) {
+    StreamAllocation allocation;
+    if (!buffer || bytes == 0) return allocation;
+    alignment = max<size_t>(alignment, 1);
+
+    // Alignment tidak harus pangkat dua (mis. stride vertex 12 byte), offset absolut yang di-align
+    size_t regionBase = persistent ? size_t(currentRegion) * regionSize : 0;
+    size_t current = head.load(memory_order_relaxed);
+    size_t start, end;
+    do {
+        size_t absolute = regionBase + current;
+        start = (absolute + alignment - 1) / alignment * alignment - regionBase;
+        end = start + bytes;
+        if (end > regionSize) {
+            overflowed = true;
+            return allocation;
+        }
+    } while (!head.compare_exchange_weak(current, end, memory_order_relaxed));
+
+    allocation.offset = GLintptr(regionBase + start);
+    allocation.size = bytes;
+    allocation.data = persistent ? mapped + regionBase + start : staging.data() + start;
+    return allocation;
+}
+
+void StreamBuffer::Flush() {
+    // Mapping coherent: tulisan CPU terlihat oleh draw berikutnya tanpa upload
+    if (!buffer || persistent) return;
+
+    size_t end = head.load(memory_order_acquire);
+    if (end <= flushedHead) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (!orphanedThisFrame) {
+        // Orphan sekali per frame, draw frame lalu tetap membaca storage lama
+        glBufferData(GL_ARRAY_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+        orphanedThisFrame = true;
+        flushedHead = 0;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, flushedHead, end - flushedHead, staging.data() + flushedHead);
+    flushedHead = end;
+}
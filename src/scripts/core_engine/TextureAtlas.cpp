@@ -0,0 +1,376 @@
+#include <TextureAtlas.hpp>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <json.hpp>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+#include <ImageCache.hpp>
+#include <Debugger.hpp>
+
+using namespace std;
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Skyline bottom-left packer untuk satu halaman
+class SkylinePacker {
+public:
+    explicit SkylinePacker(int size) : size(size) {
+        skyline.push_back({ 0, 0, size });
+    }
+
+    bool Insert(int width, int height, int& outX, int& outY) {
+        int bestIndex = -1, bestY = INT_MAX, bestWidth = INT_MAX;
+        for (size_t i = 0; i < skyline.size(); i++) {
+            int y = 0;
+            if (!Fits(i, width, height, y)) continue;
+            if (y < bestY || (y == bestY && skyline[i].width < bestWidth)) {
+                bestIndex = static_cast<int>(i);
+                bestY = y;
+                bestWidth = skyline[i].width;
+            }
+        }
+        if (bestIndex < 0) return false;
+
+        outX = skyline[bestIndex].x;
+        outY = bestY;
+        AddLevel(bestIndex, outX, outY, width, height);
+        return true;
+    }
+
+private:
+    struct Node { int x, y, width; };
+
+    bool Fits(size_t index, int width, int height, int& outY) const {
+        int x = skyline[index].x;
+        if (x + width > size) return false;
+
+        int remaining = width;
+        int y = skyline[index].y;
+        for (size_t i = index; remaining > 0; i++) {
+            if (i >= skyline.size()) return false;
+            y = max(y, skyline[i].y);
+            if (y + height > size) return false;
+            remaining -= skyline[i].width;
+        }
+        outY = y;
+        return true;
+    }
+
+    void AddLevel(size_t index, int x, int y, int width, int height) {
+        skyline.insert(skyline.begin() + index, { x, y + height, width });
+
+        // Potong node di kanan yang tertutup level baru
+        for (size_t i = index + 1; i < skyline.size();) {
+            int prevRight = skyline[i - 1].x + skyline[i - 1].width;
+            if (skyline[i].x >= prevRight) break;
+
+            int shrink = prevRight - skyline[i].x;
+            skyline[i].x += shrink;
+            skyline[i].width -= shrink;
+            if (skyline[i].width > 0) break;
+            skyline.erase(skyline.begin() + i);
+        }
+
+        // Gabungkan node bersebelahan dengan tinggi sama
+        for (size_t i = 0; i + 1 < skyline.size();) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + i + 1);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    int size;
+    vector<Node> skyline;
+};
+
+// Ukuran sel dibulatkan ke kelipatan 2^MaxMipLevel supaya blok mip tidak melewati batas sprite
+int AlignCell(int value) {
+    const int alignment = 1 << TextureAtlas::MaxMipLevel;
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+uint64_t HashPaths(const vector<string>& paths) {
+    // FNV-1a
+    uint64_t hash = 1469598103934665603ull;
+    for (const string& path : paths) {
+        for (unsigned char c : path) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        hash ^= 0xFF;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+TextureAtlas::~TextureAtlas() {
+    Clear();
+}
+
+void TextureAtlas::Clear() {
+    for (GLuint page : pages) {
+        if (page) glDeleteTextures(1, &page);
+    }
+    pages.clear();
+    regions.clear();
+    sources.clear();
+}
+
+bool TextureAtlas::Lookup(const string& path, GLuint& texture, glm::vec4& uvRect, SpriteAlphaMode* alphaMode) const {
+    auto it = regions.find(path);
+    if (it == regions.end()) return false;
+    texture = pages[it->second.page];
+    uvRect = it->second.uvRect;
+    if (alphaMode) *alphaMode = it->second.alphaMode;
+    return true;
+}
+
+void TextureAtlas::AddRegion(const string& path, uint32_t page, int x, int y, int width, int height, SpriteAlphaMode alphaMode) {
+    AtlasRegion region;
+    region.page = page;
+    region.x = x;
+    region.y = y;
+    region.width = width;
+    region.height = height;
+    const float inv = 1.0f / PageSize;
+    region.uvRect = glm::vec4(x * inv, y * inv, (x + width) * inv, (y + height) * inv);
+    region.alphaMode = alphaMode;
+    regions[path] = region;
+}
+
+bool TextureAtlas::Build(const vector<string>& paths, const string& cacheDir) {
+    Clear();
+
+    // Sumber disortir supaya key cache tidak tergantung urutan object di scene
+    vector<string> sorted = paths;
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+    sources = sorted;
+
+    // Signature sumber: path, waktu modifikasi dan ukuran file
+    json signature = json::array();
+    for (const string& path : sources) {
+        error_code ec;
+        auto mtime = fs::last_write_time(path, ec);
+        auto size = ec ? 0 : fs::file_size(path, ec);
+        signature.push_back({
+            {"path", path},
+            {"mtime", ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count())},
+            {"size", ec ? 0 : static_cast<uint64_t>(size)}
+        });
+    }
+    // Sprite diambil dari level 0 hasil cook, BC membuat pixel halaman berbeda
+    signature.push_back({ {"compress", ImageCache::Shared().GetCookOptions().compress} });
+
+    char key[17];
+    snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(HashPaths(sources)));
+    string pagePrefix = (fs::path(cacheDir) / (string("atlas_") + key)).string();
+    string layoutPath = pagePrefix + ".json";
+
+    if (LoadFromCache(layoutPath, signature.dump())) {
+        Debug::Logger::Log("[TextureAtlas] Loaded cached atlas: " + to_string(regions.size()) + " sprites, " + to_string(pages.size()) + " pages", Debug::LogLevel::SUCCESS);
+        return true;
+    }
+
+    Clear();
+    sources = sorted;
+
+    error_code ec;
+    fs::create_directories(cacheDir, ec);
+    if (!PackAndSave(layoutPath, pagePrefix, signature.dump())) {
+        cerr << "[TextureAtlas] Failed to build atlas" << endl;
+        return false;
+    }
+    Debug::Logger::Log("[TextureAtlas] Built atlas: " + to_string(regions.size()) + " sprites, " + to_string(pages.size()) + " pages", Debug::LogLevel::SUCCESS);
+    return true;
+}
+
+bool TextureAtlas::LoadFromCache(const string& layoutPath, const string& signature) {
+    if (!fs::exists(layoutPath)) return false;
+
+    try {
+        ifstream in(layoutPath);
+        if (!in.is_open()) return false;
+        json layout;
+        in >> layout;
+
+        if (layout.value("version", 0) != FormatVersion ||
+            layout.value("pageSize", 0) != PageSize ||
+            layout.value("gutter", 0) != Gutter ||
+            layout["sources"].dump() != signature) {
+            return false;
+        }
+
+        // Halaman disimpan sebagai .ilmeetex RGBA8, di-key dengan hash signature: di-map dan di-upload tanpa decode
+        uint64_t pageHash = TextureCooker::HashBytes(reinterpret_cast<const unsigned char*>(signature.data()), signature.size());
+        for (const auto& pagePath : layout["pages"]) {
+            MappedFile mapped;
+            CookedTexture cooked;
+            if (!mapped.Open(pagePath.get<string>()) ||
+                !TextureCooker::Parse(mapped.GetData(), mapped.GetSize(), pageHash, cooked) ||
+                cooked.GetFormat() != CookedTextureFormat::RGBA8 ||
+                cooked.header->width != uint32_t(PageSize) || cooked.header->height != uint32_t(PageSize)) {
+                return false;
+            }
+            pages.push_back(UploadPage(cooked.GetLevelData(0)));
+        }
+
+        for (const auto& jRegion : layout["regions"]) {
+            uint32_t page = jRegion["page"];
+            if (page >= pages.size()) return false;
+            int alpha = jRegion.value("alpha", (int)SpriteAlphaMode::TRANSLUCENT);
+            AddRegion(jRegion["path"], page, jRegion["x"], jRegion["y"], jRegion["w"], jRegion["h"],
+                      static_cast<SpriteAlphaMode>(min(max(alpha, 0), (int)SpriteAlphaMode::TRANSLUCENT)));
+        }
+    } catch (const exception& e) {
+        cerr << "[TextureAtlas] Invalid atlas cache " << layoutPath << ": " << e.what() << endl;
+        return false;
+    }
+    return true;
+}
+
+bool TextureAtlas::PackAndSave(const string& layoutPath, const string& pagePrefix, const string& signature) {
+    struct Entry {
+        string path;
+        int width, height;
+        uint32_t page;
+        int x, y;
+        SpriteAlphaMode alphaMode;
+        vector<unsigned char> pixels;
+    };
+
+    // Decode lewat ImageCache supaya .ilmeetex yang sama dipakai ulang oleh texture sendiri dan icon editor.
+    // Level 0 sudah RGBA8 baris bawah dulu (BC di-decode di CPU kalau kompresi aktif).
+    vector<Entry> entries;
+    for (const string& path : sources) {
+        DecodedImage image;
+        if (!ImageCache::Shared().Decode(path, image)) continue;
+        int w = int(image.cooked.header->width), h = int(image.cooked.header->height);
+        if (w <= 0 || h <= 0 || w > MaxSpriteSize || h > MaxSpriteSize) continue;
+        Entry entry = { path, w, h, 0, 0, 0, SpriteAlphaMode(image.cooked.header->alphaMode), {} };
+        if (!TextureCooker::DecodeLevel(image.cooked, 0, entry.pixels)) continue;
+        entries.push_back(move(entry));
+    }
+
+    // Sprite tinggi dulu, skyline paling rapat dengan urutan ini
+    sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        if (a.height != b.height) return a.height > b.height;
+        return a.width > b.width;
+    });
+
+    vector<SkylinePacker> packers;
+    for (Entry& entry : entries) {
+        int cellW = AlignCell(entry.width + Gutter * 2);
+        int cellH = AlignCell(entry.height + Gutter * 2);
+        int cellX = 0, cellY = 0;
+        bool placed = false;
+        for (size_t p = 0; p < packers.size() && !placed; p++) {
+            if (packers[p].Insert(cellW, cellH, cellX, cellY)) {
+                entry.page = static_cast<uint32_t>(p);
+                placed = true;
+            }
+        }
+        if (!placed) {
+            packers.emplace_back(PageSize);
+            packers.back().Insert(cellW, cellH, cellX, cellY);
+            entry.page = static_cast<uint32_t>(packers.size() - 1);
+        }
+        entry.x = cellX + Gutter;
+        entry.y = cellY + Gutter;
+    }
+
+    // Blit ke halaman, baris 0 = bawah seperti texture GL lainnya
+    vector<vector<unsigned char>> pagePixels(packers.size(), vector<unsigned char>(size_t(PageSize) * PageSize * 4, 0));
+    for (Entry& entry : entries) {
+        int w = entry.width, h = entry.height;
+        const unsigned char* pixels = entry.pixels.data();
+
+        // Tepi sprite di-extrude ke gutter supaya filter dan mip tidak mengambil sprite tetangga
+        unsigned char* dst = pagePixels[entry.page].data();
+        for (int py = -Gutter; py < h + Gutter; py++) {
+            int sy = min(max(py, 0), h - 1);
+            for (int px = -Gutter; px < w + Gutter; px++) {
+                int sx = min(max(px, 0), w - 1);
+                const unsigned char* src = pixels + (size_t(sy) * w + sx) * 4;
+                unsigned char* out = dst + (size_t(entry.y + py) * PageSize + (entry.x + px)) * 4;
+                out[0] = src[0];
+                out[1] = src[1];
+                out[2] = src[2];
+                out[3] = src[3];
+            }
+        }
+        AddRegion(entry.path, entry.page, entry.x, entry.y, w, h, entry.alphaMode);
+        entry.pixels = vector<unsigned char>();
+    }
+
+    json layout;
+    layout["version"] = FormatVersion;
+    layout["pageSize"] = PageSize;
+    layout["gutter"] = Gutter;
+    layout["sources"] = json::parse(signature);
+    layout["pages"] = json::array();
+    layout["regions"] = json::array();
+
+    // Tanpa kompresi: BC akan mencampur gutter dan sprite tetangga dalam satu blok
+    uint64_t pageHash = TextureCooker::HashBytes(reinterpret_cast<const unsigned char*>(signature.data()), signature.size());
+    for (size_t p = 0; p < pagePixels.size(); p++) {
+        pages.push_back(UploadPage(pagePixels[p].data()));
+
+        string pagePath = pagePrefix + "_" + to_string(p) + ".ilmeetex";
+        vector<unsigned char> blob = TextureCooker::Cook(pagePixels[p].data(), PageSize, PageSize, SpriteAlphaMode::TRANSLUCENT,
+                                                         pageHash, TextureCookOptions());
+        if (!TextureCooker::WriteCacheFile(pagePath, blob)) {
+            cerr << "[TextureAtlas] Failed to write atlas page: " << pagePath << endl;
+        }
+        layout["pages"].push_back(pagePath);
+    }
+
+    for (const auto& [path, region] : regions) {
+        layout["regions"].push_back({
+            {"path", path},
+            {"page", region.page},
+            {"x", region.x},
+            {"y", region.y},
+            {"w", region.width},
+            {"h", region.height},
+            {"alpha", (int)region.alphaMode}
+        });
+    }
+
+    ofstream out(layoutPath);
+    if (!out.is_open()) {
+        // Atlas tetap bisa dipakai, hanya tidak di-cache
+        cerr << "[TextureAtlas] Could not write atlas layout: " << layoutPath << endl;
+        return true;
+    }
+    out << layout.dump(4);
+    return true;
+}
+
+GLuint TextureAtlas::UploadPage(const unsigned char* pixels) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // Mip di atas level ini akan mencampur gutter sprite tetangga
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, MaxMipLevel);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PageSize, PageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    return texture;
+}
@@ -0,0 +1,415 @@
+#include <TextureCooker.hpp>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+const char Magic[4] = { 'I', 'L', 'T', 'X' };
+// Data tiap level dimulai di kelipatan 16 byte
+const uint64_t LevelAlignment = 16;
+
+uint64_t AlignUp(uint64_t value) {
+    return (value + LevelAlignment - 1) & ~(LevelAlignment - 1);
+}
+
+uint64_t LevelSize(CookedTextureFormat format, uint32_t width, uint32_t height) {
+    if (format == CookedTextureFormat::RGBA8) return uint64_t(width) * height * 4;
+    uint64_t blocks = uint64_t((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * (format == CookedTextureFormat::BC1 ? 8 : 16);
+}
+
+// Box filter 2x2, sisi ganjil memakai pixel terakhir dua kali
+void Downsample(const vector<unsigned char>& src, int width, int height, vector<unsigned char>& dst, int& outWidth, int& outHeight) {
+    outWidth = max(1, width / 2);
+    outHeight = max(1, height / 2);
+    dst.resize(size_t(outWidth) * outHeight * 4);
+    for (int y = 0; y < outHeight; y++) {
+        int y0 = min(y * 2, height - 1), y1 = min(y * 2 + 1, height - 1);
+        for (int x = 0; x < outWidth; x++) {
+            int x0 = min(x * 2, width - 1), x1 = min(x * 2 + 1, width - 1);
+            const unsigned char* p00 = &src[(size_t(y0) * width + x0) * 4];
+            const unsigned char* p01 = &src[(size_t(y0) * width + x1) * 4];
+            const unsigned char* p10 = &src[(size_t(y1) * width + x0) * 4];
+            const unsigned char* p11 = &src[(size_t(y1) * width + x1) * 4];
+            unsigned char* out = &dst[(size_t(y) * outWidth + x) * 4];
+            for (int c = 0; c < 4; c++) out[c] = (unsigned char)((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+        }
+    }
+}
+
+uint16_t To565(const unsigned char* rgb) {
+    return uint16_t(((rgb[0] * 31 + 127) / 255) << 11 | ((rgb[1] * 63 + 127) / 255) << 5 | ((rgb[2] * 31 + 127) / 255));
+}
+
+void From565(uint16_t color, int* rgb) {
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Blok warna BC1 mode 4 warna: endpoint dari bounding box RGB (sedikit di-inset), index ke warna palet terdekat
+void EncodeColorBlock(const unsigned char* block, unsigned char* out) {
+    unsigned char lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) {
+            lo[c] = min(lo[c], block[i * 4 + c]);
+            hi[c] = max(hi[c], block[i * 4 + c]);
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        int inset = (hi[c] - lo[c]) / 16;
+        lo[c] = (unsigned char)(lo[c] + inset);
+        hi[c] = (unsigned char)(hi[c] - inset);
+    }
+
+    uint16_t color0 = To565(hi), color1 = To565(lo);
+    if (color0 < color1) swap(color0, color1);
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        From565(color0, palette[0]);
+        From565(color1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestError = INT32_MAX;
+            for (int p = 0; p < 4; p++) {
+                int error = 0;
+                for (int c = 0; c < 3; c++) {
+                    int d = block[i * 4 + c] - palette[p][c];
+                    error += d * d;
+                }
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= uint32_t(best) << (i * 2);
+        }
+    }
+    out[0] = uint8_t(color0); out[1] = uint8_t(color0 >> 8);
+    out[2] = uint8_t(color1); out[3] = uint8_t(color1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = uint8_t(indices >> (i * 8));
+}
+
+// Blok alpha BC3 mode 8 nilai (alpha0 > alpha1)
+void EncodeAlphaBlock(const unsigned char* block, unsigned char* out) {
+    int lo = 255, hi = 0;
+    for (int i = 0; i < 16; i++) {
+        lo = min(lo, int(block[i * 4 + 3]));
+        hi = max(hi, int(block[i * 4 + 3]));
+    }
+    uint64_t indices = 0;
+    if (hi != lo) {
+        int palette[8] = { hi, lo };
+        for (int i = 1; i <= 6; i++) palette[i + 1] = ((7 - i) * hi + i * lo) / 7;
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestError = INT32_MAX;
+            for (int p = 0; p < 8; p++) {
+                int error = abs(block[i * 4 + 3] - palette[p]);
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= uint64_t(best) << (i * 3);
+        }
+    }
+    out[0] = uint8_t(hi);
+    out[1] = uint8_t(lo);
+    for (int i = 0; i < 6; i++) out[2 + i] = uint8_t(indices >> (i * 8));
+}
+
+void DecodeColorBlock(const unsigned char* in, unsigned char* block) {
+    uint16_t color0 = uint16_t(in[0] | in[1] << 8), color1 = uint16_t(in[2] | in[3] << 8);
+    int palette[4][3];
+    From565(color0, palette[0]);
+    From565(color1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        if (color0 > color1) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            // Mode 3 warna, index 3 hitam
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    uint32_t indices = uint32_t(in[4] | in[5] << 8 | in[6] << 16 | uint32_t(in[7]) << 24);
+    for (int i = 0; i < 16; i++) {
+        const int* color = palette[(indices >> (i * 2)) & 3];
+        for (int c = 0; c < 3; c++) block[i * 4 + c] = (unsigned char)color[c];
+    }
+}
+
+void DecodeAlphaBlock(const unsigned char* in, unsigned char* block) {
+    int palette[8] = { in[0], in[1] };
+    if (palette[0] > palette[1]) {
+        for (int i = 1; i <= 6; i++) palette[i + 1] = ((7 - i) * palette[0] + i * palette[1]) / 7;
+    } else {
+        for (int i = 1; i <= 4; i++) palette[i + 1] = ((5 - i) * palette[0] + i * palette[1]) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++) indices |= uint64_t(in[2 + i]) << (i * 8);
+    for (int i = 0; i < 16; i++) block[i * 4 + 3] = (unsigned char)palette[(indices >> (i * 3)) & 7];
+}
+
+void EncodeLevel(const vector<unsigned char>& pixels, int width, int height, CookedTextureFormat format, unsigned char* out) {
+    if (format == CookedTextureFormat::RGBA8) {
+        memcpy(out, pixels.data(), pixels.size());
+        return;
+    }
+    // Blok di tepi yang tidak penuh mengulang pixel terakhir
+    unsigned char block[64];
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            for (int i = 0; i < 16; i++) {
+                int x = min(bx + (i & 3), width - 1), y = min(by + (i >> 2), height - 1);
+                memcpy(&block[i * 4], &pixels[(size_t(y) * width + x) * 4], 4);
+            }
+            if (format == CookedTextureFormat::BC3) {
+                EncodeAlphaBlock(block, out);
+                out += 8;
+            }
+            EncodeColorBlock(block, out);
+            out += 8;
+        }
+    }
+}
+
+} // namespace
+
+uint64_t CookedTexture::GetTotalBytes() const {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < header->mipCount; i++) total += levels[i].size;
+    return total;
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const string& path) {
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const unsigned char*>(view);
+    size = size_t(fileSize.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // Mapping tetap berlaku setelah descriptor ditutup
+    close(fd);
+    if (view == MAP_FAILED) return false;
+    data = static_cast<const unsigned char*>(view);
+    size = size_t(info.st_size);
+#endif
+    return true;
+}
+
+void MappedFile::Close() {
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    fileHandle = mappingHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+uint64_t TextureCooker::HashBytes(const unsigned char* data, size_t size) {
+    // FNV-1a
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+string TextureCooker::GetCachePath(const string& cacheDir, uint64_t sourceHash, const TextureCookOptions& options) {
+    char name[40];
+    snprintf(name, sizeof(name), "%016llx_%s.ilmeetex", static_cast<unsigned long long>(sourceHash), options.compress ? "bc" : "rgba");
+    return (fs::path(cacheDir) / name).string();
+}
+
+bool TextureCooker::IsCookable(const string& path) {
+    string ext = fs::path(path).extension().string();
+    transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tga";
+}
+
+vector<unsigned char> TextureCooker::Cook(const unsigned char* pixels, int width, int height, SpriteAlphaMode alphaMode,
+                                          uint64_t sourceHash, const TextureCookOptions& options) {
+    CookedTextureFormat format = CookedTextureFormat::RGBA8;
+    if (options.compress) format = alphaMode == SpriteAlphaMode::SOLID ? CookedTextureFormat::BC1 : CookedTextureFormat::BC3;
+
+    // Mip chain lengkap sampai 1x1, sama dengan glGenerateMipmap
+    vector<vector<unsigned char>> mips(1);
+    vector<pair<int, int>> sizes = { { width, height } };
+    mips[0].assign(pixels, pixels + size_t(width) * height * 4);
+    while (sizes.back().first > 1 || sizes.back().second > 1) {
+        vector<unsigned char> next;
+        int nextWidth, nextHeight;
+        Downsample(mips.back(), sizes.back().first, sizes.back().second, next, nextWidth, nextHeight);
+        mips.push_back(move(next));
+        sizes.push_back({ nextWidth, nextHeight });
+    }
+
+    uint32_t mipCount = uint32_t(mips.size());
+    vector<CookedMipLevel> levels(mipCount);
+    uint64_t offset = AlignUp(sizeof(CookedTextureHeader) + sizeof(CookedMipLevel) * mipCount);
+    for (uint32_t i = 0; i < mipCount; i++) {
+        levels[i].width = uint32_t(sizes[i].first);
+        levels[i].height = uint32_t(sizes[i].second);
+        levels[i].offset = offset;
+        levels[i].size = LevelSize(format, levels[i].width, levels[i].height);
+        offset = AlignUp(offset + levels[i].size);
+    }
+
+    vector<unsigned char> blob(offset, 0);
+    CookedTextureHeader header;
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FormatVersion;
+    header.sourceHash = sourceHash;
+    header.format = uint32_t(format);
+    header.width = uint32_t(width);
+    header.height = uint32_t(height);
+    header.mipCount = mipCount;
+    header.alphaMode = uint32_t(alphaMode);
+    header.reserved = 0;
+    memcpy(blob.data(), &header, sizeof(header));
+    memcpy(blob.data() + sizeof(header), levels.data(), sizeof(CookedMipLevel) * mipCount);
+    for (uint32_t i = 0; i < mipCount; i++) {
+        EncodeLevel(mips[i], sizes[i].first, sizes[i].second, format, blob.data() + levels[i].offset);
+    }
+    return blob;
+}
+
+bool TextureCooker::Parse(const unsigned char* data, size_t size, uint64_t sourceHash, CookedTexture& texture) {
+    if (!data || size < sizeof(CookedTextureHeader)) return false;
+    const CookedTextureHeader* header = reinterpret_cast<const CookedTextureHeader*>(data);
+    if (memcmp(header->magic, Magic, sizeof(Magic)) != 0 || header->version != FormatVersion ||
+        header->sourceHash != sourceHash || header->format > uint32_t(CookedTextureFormat::BC3) ||
+        header->alphaMode > uint32_t(SpriteAlphaMode::TRANSLUCENT) ||
+        header->width == 0 || header->height == 0 || header->mipCount == 0 || header->mipCount > 32) {
+        return false;
+    }
+    if (size < sizeof(CookedTextureHeader) + sizeof(CookedMipLevel) * header->mipCount) return false;
+
+    const CookedMipLevel* levels = reinterpret_cast<const CookedMipLevel*>(data + sizeof(CookedTextureHeader));
+    for (uint32_t i = 0; i < header->mipCount; i++) {
+        if (levels[i].offset > size || levels[i].size > size - levels[i].offset ||
+            levels[i].size != LevelSize(CookedTextureFormat(header->format), levels[i].width, levels[i].height)) {
+            return false;
+        }
+    }
+    texture.header = header;
+    texture.levels = levels;
+    texture.data = data;
+    return true;
+}
+
+bool TextureCooker::DecodeLevel(const CookedTexture& texture, uint32_t level, vector<unsigned char>& pixels) {
+    if (!texture.header || level >= texture.header->mipCount) return false;
+    const CookedMipLevel& mip = texture.levels[level];
+    const unsigned char* in = texture.GetLevelData(level);
+    CookedTextureFormat format = texture.GetFormat();
+    pixels.resize(size_t(mip.width) * mip.height * 4);
+    if (format == CookedTextureFormat::RGBA8) {
+        memcpy(pixels.data(), in, pixels.size());
+        return true;
+    }
+
+    unsigned char block[64];
+    for (uint32_t by = 0; by < mip.height; by += 4) {
+        for (uint32_t bx = 0; bx < mip.width; bx += 4) {
+            memset(block, 255, sizeof(block));
+            if (format == CookedTextureFormat::BC3) {
+                DecodeAlphaBlock(in, block);
+                in += 8;
+            }
+            DecodeColorBlock(in, block);
+            in += 8;
+            // Blok di tepi yang tidak penuh: pixel di luar level dibuang
+            for (int i = 0; i < 16; i++) {
+                uint32_t x = bx + (i & 3), y = by + (i >> 2);
+                if (x < mip.width && y < mip.height) memcpy(&pixels[(size_t(y) * mip.width + x) * 4], &block[i * 4], 4);
+            }
+        }
+    }
+    return true;
+}
+
+bool TextureCooker::WriteCacheFile(const string& path, const vector<unsigned char>& blob) {
+    error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    string tempPath = path + ".tmp" + to_string(hash<thread::id>()(this_thread::get_id()));
+    {
+        ofstream out(tempPath, ios::binary | ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(reinterpret_cast<const char*>(blob.data()), streamsize(blob.size()));
+        if (!out) {
+            out.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool TextureCooker::ReadFile(const string& path, vector<unsigned char>& bytes) {
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in.is_open()) return false;
+    streamsize size = in.tellg();
+    if (size <= 0) return false;
+    bytes.resize(size_t(size));
+    in.seekg(0);
+    return bool(in.read(reinterpret_cast<char*>(bytes.data()), size));
+}
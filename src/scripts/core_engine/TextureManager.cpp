@@ -6,107 +6,446 @@
 #include <filesystem>
 #include <Debugger.hpp>
 #include <algorithm>
+#include <chrono>
 // #include <assets.hpp>
 
 using namespace std;
 
 TextureManager::~TextureManager() {
+    {
+        lock_guard<std::mutex> lock(streamMutex);
+        stopping = true;
+    }
+    streamWake.notify_all();
+    for (thread& decoder : decoders) decoder.join();
+
     ClearTextures();
+    if (placeholderTexture) glDeleteTextures(1, &placeholderTexture);
 }
 
-GLuint TextureManager::LoadTexture(const std::string& path) {
-    // Convert path to absolute path and normalize it
+std::string TextureManager::NormalizePath(const std::string& path) {
     std::string normalizedPath = path;
     std::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
-    
-    // Check if texture is already loaded
+    return normalizedPath;
+}
+
+GLuint TextureManager::LoadTexture(const std::string& path) {
+    // Convert path to absolute path and normalize it
+    std::string normalizedPath = NormalizePath(path);
+
+    // Check if texture is already loaded, placeholder berarti masih di-decode: load langsung di sini
     auto it = textureCache.find(normalizedPath);
-    if (it != textureCache.end()) {
+    if (it != textureCache.end() && it->second != placeholderTexture) {
         // Debug::Logger::Log("Texture already loaded: " + normalizedPath, Debug::LogLevel::SUCCESS);
         return it->second;
     }
-    
-    // Verify file exists before attempting to load
-    if (!std::filesystem::exists(normalizedPath)) {
-        std::cerr << "ERROR: File does not exist: " << normalizedPath << std::endl;
-        // Return a default texture ID or 0
-        return 0;
-    }
-    
+
     cout << "Loading texture from path: " << normalizedPath << endl;
-    
-    // Load image from file with error handling
-    int width = 0, height = 0, channels = 0;
-    stbi_set_flip_vertically_on_load(true); // Flip textures to match OpenGL's coordinate system
-    
-    unsigned char* data = nullptr;
-    try {
-        data = stbi_load(normalizedPath.c_str(), &width, &height, &channels, 0);
-    }
-    catch (const std::exception& e) {
-        std::cerr << "Exception loading texture: " << e.what() << std::endl;
-        return 0;
+
+    // Decode dan upload lewat cache bersama, gambar yang sudah dibuka editor tidak di-decode ulang
+    ImageView view = ImageCache::Shared().Acquire(normalizedPath, ImageVariant::FULL);
+    if (view.texture == 0) return 0;
+
+    // Store texture in cache, hasil decode background untuk path ini nanti dibuang
+    textureCache[normalizedPath] = view.texture;
+    alphaModes[normalizedPath] = view.alphaMode;
+    pendingPaths.erase(normalizedPath);
+    evictedPaths.erase(normalizedPath);
+    TrackResident(normalizedPath, view.bytes);
+    UpdateSlot(normalizedPath);
+
+    std::cout << "Successfully loaded texture: " << normalizedPath
+              << " (" << view.width << "x" << view.height << "), ID: " << view.texture << std::endl;
+
+    return view.texture;
+}
+
+GLuint TextureManager::GetPlaceholderTexture() {
+    if (placeholderTexture) return placeholderTexture;
+
+    const unsigned char pixels[16] = {
+        96, 96, 96, 255,    128, 128, 128, 255,
+        128, 128, 128, 255, 96, 96, 96, 255
+    };
+    glGenTextures(1, &placeholderTexture);
+    glBindTexture(GL_TEXTURE_2D, placeholderTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return placeholderTexture;
+}
+
+void TextureManager::QueueDecode(const std::string& normalizedPath) {
+    // Placeholder opaque sampai texture asli di-upload, worker sudah bisa menemukannya lewat FindTexture
+    pendingPaths.insert(normalizedPath);
+    textureCache[normalizedPath] = GetPlaceholderTexture();
+    alphaModes[normalizedPath] = SpriteAlphaMode::SOLID;
+
+    {
+        lock_guard<std::mutex> lock(streamMutex);
+        if (decoders.empty()) {
+            // Decode kebanyakan menunggu disk dan inflate, tidak perlu semua core
+            unsigned count = max(1u, min(4u, thread::hardware_concurrency() / 2));
+            for (unsigned i = 0; i < count; i++) decoders.emplace_back(&TextureManager::DecoderLoop, this);
+        }
+        decodeQueue.push_back({ normalizedPath, streamGeneration });
     }
-    
-    if (!data) {
-        std::cerr << "Failed to load texture: " << normalizedPath << " - " << stbi_failure_reason() << std::endl;
-        return 0;
+    streamWake.notify_one();
+}
+
+GLuint TextureManager::RequestTexture(const std::string& path) {
+    auto it = textureCache.find(path);
+    if (it == textureCache.end()) {
+        std::string normalizedPath = NormalizePath(path);
+        it = textureCache.find(normalizedPath);
+        if (it == textureCache.end()) {
+            if (failedPaths.count(normalizedPath)) return 0;
+            if (evictedPaths.erase(normalizedPath)) streamStats.restreamed++;
+            // Sudah di-upload pemakai lain cache (editor, renderer lain): pakai langsung tanpa decode
+            ImageView view = ImageCache::Shared().AcquireResident(normalizedPath);
+            if (view.texture) {
+                textureCache[normalizedPath] = view.texture;
+                alphaModes[normalizedPath] = view.alphaMode;
+                TrackResident(normalizedPath, view.bytes);
+                return view.texture;
+            }
+            QueueDecode(normalizedPath);
+            return placeholderTexture;
+        }
+    }
+
+    // Dipakai lewat path (tileset, emitter) setiap frame, LRU tidak boleh meng-evict-nya
+    auto record = residency.find(it->first);
+    if (record != residency.end()) record->second.lastUsedFrame = residencyFrame;
+    return it->second;
+}
+
+void TextureManager::Prefetch(const std::vector<std::string>& paths) {
+    for (const std::string& path : paths) {
+        if (!path.empty()) RequestTexture(path);
     }
-    
-    // Create OpenGL texture with error checking
-    GLuint textureID = 0;
-    glGenTextures(1, &textureID);
-    
-    if (textureID == 0) {
-        std::cerr << "Failed to generate texture ID" << std::endl;
-        stbi_image_free(data);
+}
+
+void TextureManager::DecoderLoop() {
+    while (true) {
+        DecodeJob job;
+        {
+            unique_lock<std::mutex> lock(streamMutex);
+            streamWake.wait(lock, [this] { return stopping || !decodeQueue.empty(); });
+            if (stopping) return;
+            job = move(decodeQueue.front());
+            decodeQueue.pop_front();
+            decoding++;
+        }
+
+        DecodedImage image;
+        image.path = move(job.path);
+        image.generation = job.generation;
+        ImageCache::Shared().Decode(image.path, image);
+
+        {
+            lock_guard<std::mutex> lock(streamMutex);
+            decodedImages.push_back(move(image));
+            decoding--;
+        }
+        streamIdle.notify_all();
+    }
+}
+
+bool TextureManager::FinishImage(DecodedImage& image) {
+    // Sudah di-load sinkron atau cache di-clear sejak request
+    if (image.generation != streamGeneration || !pendingPaths.count(image.path)) return false;
+    pendingPaths.erase(image.path);
+
+    ImageView view = image.IsValid() ? ImageCache::Shared().Insert(image) : ImageView();
+    if (view.texture == 0) {
+        textureCache.erase(image.path);
+        alphaModes.erase(image.path);
+        failedPaths.insert(image.path);
+        streamStats.failed++;
+    } else {
+        textureCache[image.path] = view.texture;
+        alphaModes[image.path] = view.alphaMode;
+        TrackResident(image.path, view.bytes);
+        streamStats.totalUploaded++;
+        if (image.fromCache) streamStats.cookedHits++;
+        else streamStats.cooked++;
+    }
+    UpdateSlot(image.path);
+    return true;
+}
+
+size_t TextureManager::ProcessUploads() {
+    streamStats.uploadedLastFrame = 0;
+    streamStats.uploadedBytesLastFrame = 0;
+    streamStats.uploadMs = 0.0f;
+    {
+        lock_guard<std::mutex> lock(streamMutex);
+        for (DecodedImage& image : decodedImages) uploadQueue.push_back(move(image));
+        decodedImages.clear();
+        streamStats.queued = uint32_t(decodeQueue.size()) + decoding;
+    }
+    if (uploadQueue.empty()) {
+        streamStats.ready = 0;
         return 0;
     }
-    
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    // Set texture wrapping/filtering options
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    // Upload data and generate mipmaps
-    GLenum format = channels == 4 ? GL_RGBA : GL_RGB;
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    
-    // Free image data
-    stbi_image_free(data);
-    
-    // Store texture in cache
-    textureCache[normalizedPath] = textureID;
-    
-    std::cout << "Successfully loaded texture: " << normalizedPath
-              << " (" << width << "x" << height
-              << ", " << channels << " channels), ID: " << textureID << std::endl;
-    
-    return textureID;
+
+    // Budget waktu dan byte per frame, minimal satu texture supaya streaming selalu maju
+    auto start = chrono::steady_clock::now();
+    size_t changed = 0;
+    while (!uploadQueue.empty()) {
+        DecodedImage& image = uploadQueue.front();
+        uint64_t bytes = image.IsValid() ? image.cooked.GetTotalBytes() : 0;
+        if (streamStats.uploadedLastFrame > 0) {
+            float elapsed = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+            if (elapsed >= uploadBudgetMs || streamStats.uploadedBytesLastFrame + bytes > uploadBudgetBytes) break;
+        }
+
+        bool uploaded = image.IsValid();
+        if (FinishImage(image)) {
+            changed++;
+            if (uploaded) {
+                streamStats.uploadedLastFrame++;
+                streamStats.uploadedBytesLastFrame += bytes;
+            }
+        }
+        uploadQueue.pop_front();
+    }
+    streamStats.ready = uint32_t(uploadQueue.size());
+    streamStats.uploadMs = chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+    return changed;
+}
+
+size_t TextureManager::FinishStreaming() {
+    {
+        unique_lock<std::mutex> lock(streamMutex);
+        streamIdle.wait(lock, [this] { return decodeQueue.empty() && decoding == 0; });
+    }
+    float budgetMs = uploadBudgetMs;
+    size_t budgetBytes = uploadBudgetBytes;
+    uploadBudgetMs = 1e9f;
+    uploadBudgetBytes = SIZE_MAX;
+    size_t changed = ProcessUploads();
+    uploadBudgetMs = budgetMs;
+    uploadBudgetBytes = budgetBytes;
+    return changed;
 }
 
 GLuint TextureManager::GetTexture(const std::string& path) const {
-    std::string normalizedPath = path;
-    std::replace(normalizedPath.begin(), normalizedPath.end(), '\\', '/');
-    
+    std::string normalizedPath = NormalizePath(path);
+
     auto it = textureCache.find(normalizedPath);
     if (it != textureCache.end()) {
         return it->second;
     }
-    
+
     std::cerr << "Warning: Texture not found in cache: " << normalizedPath << std::endl;
     return 0;
 }
 
+GLuint TextureManager::FindTexture(const std::string& path, SpriteAlphaMode* alphaMode) const {
+    // Path dari scene hampir selalu sudah pakai '/', copy hanya dibuat kalau perlu dinormalisasi
+    auto it = textureCache.find(path);
+    if (it == textureCache.end() && path.find('\\') != std::string::npos) {
+        it = textureCache.find(NormalizePath(path));
+    }
+    if (it == textureCache.end()) return 0;
+
+    if (alphaMode) {
+        auto mode = alphaModes.find(it->first);
+        *alphaMode = mode != alphaModes.end() ? mode->second : SpriteAlphaMode::TRANSLUCENT;
+    }
+    return it->second;
+}
+
+TextureHandle TextureManager::AllocateSlot(const std::string& normalizedPath, const TextureSlot& value) {
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = uint32_t(textureSlots.size());
+        textureSlots.emplace_back();
+    }
+    // Generation slot lama dipertahankan supaya handle lama tetap basi
+    TextureSlot& slot = textureSlots[index];
+    uint32_t generation = slot.generation;
+    slot = value;
+    slot.generation = generation;
+    slot.refs = 1;
+    slot.lastUsedFrame = residencyFrame;
+    if (slotPaths.size() <= index) slotPaths.resize(index + 1);
+    slotPaths[index] = normalizedPath;
+    slotIndices[normalizedPath] = index;
+    return { index, generation };
+}
+
+void TextureManager::RestreamSlot(uint32_t index) {
+    TextureSlot& slot = textureSlots[index];
+    slot.evicted = false;
+    slot.texture = RequestTexture(slotPaths[index]);
+    FindTexture(slotPaths[index], &slot.alphaMode);
+}
+
+void TextureManager::UpdateSlot(const std::string& normalizedPath) {
+    auto it = slotIndices.find(normalizedPath);
+    if (it == slotIndices.end()) return;
+    TextureSlot& slot = textureSlots[it->second];
+    if (slot.region) return;
+    slot.texture = FindTexture(normalizedPath, &slot.alphaMode);
+    slot.evicted = false;
+}
+
+void TextureManager::TrackResident(const std::string& normalizedPath, uint64_t bytes) {
+    Residency& record = residency[normalizedPath];
+    streamStats.residentBytes += bytes - record.bytes;
+    record.bytes = bytes;
+    record.lastUsedFrame = residencyFrame;
+    streamStats.residentTextures = uint32_t(residency.size());
+}
+
+bool TextureManager::EvictTexture(const std::string& normalizedPath) {
+    bool freed = false;
+    auto it = textureCache.find(normalizedPath);
+    if (it != textureCache.end()) {
+        if (it->second != placeholderTexture) freed = ImageCache::Shared().Release(normalizedPath, ImageVariant::FULL);
+        textureCache.erase(it);
+    }
+    alphaModes.erase(normalizedPath);
+
+    auto record = residency.find(normalizedPath);
+    if (record != residency.end()) {
+        streamStats.residentBytes -= record->second.bytes;
+        residency.erase(record);
+    }
+    streamStats.residentTextures = uint32_t(residency.size());
+    evictedPaths.insert(normalizedPath);
+
+    // Handle tetap berlaku, slot menunjuk placeholder sampai TouchHandle meminta texture lagi
+    auto slot = slotIndices.find(normalizedPath);
+    if (slot != slotIndices.end() && !textureSlots[slot->second].region) {
+        TextureSlot& entry = textureSlots[slot->second];
+        entry.texture = GetPlaceholderTexture();
+        entry.alphaMode = SpriteAlphaMode::SOLID;
+        entry.evicted = true;
+    }
+    return freed;
+}
+
+size_t TextureManager::UpdateResidency() {
+    size_t evicted = 0;
+    if (memoryBudget > 0 && streamStats.residentBytes > memoryBudget) {
+        struct Candidate {
+            bool referenced;
+            uint64_t lastUsedFrame;
+            std::string path;
+        };
+        vector<Candidate> candidates;
+        for (const auto& [path, record] : residency) {
+            Candidate candidate{ false, record.lastUsedFrame, path };
+            auto slot = slotIndices.find(path);
+            if (slot != slotIndices.end() && !textureSlots[slot->second].region) {
+                const TextureSlot& entry = textureSlots[slot->second];
+                candidate.referenced = entry.refs > 0;
+                candidate.lastUsedFrame = max(candidate.lastUsedFrame, entry.lastUsedFrame);
+            }
+            // Dipakai di frame terakhir: kalau di-evict hanya akan di-stream ulang frame berikutnya
+            if (candidate.lastUsedFrame >= residencyFrame) continue;
+            // Juga dipegang editor (icon, background) atau renderer lain: melepasnya tidak mengurangi VRAM
+            if (!ImageCache::Shared().IsReleasable(path, ImageVariant::FULL)) continue;
+            candidates.push_back(move(candidate));
+        }
+
+        // Tanpa handle dulu, lalu yang paling lama tidak dipakai
+        sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            if (a.referenced != b.referenced) return !a.referenced;
+            return a.lastUsedFrame < b.lastUsedFrame;
+        });
+        for (const Candidate& candidate : candidates) {
+            if (streamStats.residentBytes <= memoryBudget) break;
+            if (EvictTexture(candidate.path)) evicted++;
+        }
+    }
+
+    streamStats.budgetBytes = memoryBudget;
+    streamStats.evictedLastFrame = uint32_t(evicted);
+    streamStats.totalEvicted += uint32_t(evicted);
+    residencyFrame++;
+    return evicted;
+}
+
+TextureHandle TextureManager::AcquireHandle(const std::string& path) {
+    std::string normalizedPath = NormalizePath(path);
+    auto it = slotIndices.find(normalizedPath);
+    if (it != slotIndices.end()) {
+        TextureSlot& slot = textureSlots[it->second];
+        slot.refs++;
+        return { it->second, slot.generation };
+    }
+
+    // Path kosong tetap dapat slot (texture 0) supaya tidak dicari ulang setiap frame
+    TextureSlot slot;
+    if (!normalizedPath.empty()) {
+        slot.texture = RequestTexture(normalizedPath);
+        FindTexture(normalizedPath, &slot.alphaMode);
+    }
+    return AllocateSlot(normalizedPath, slot);
+}
+
+TextureHandle TextureManager::AcquireRegionHandle(const std::string& path, GLuint texture, const glm::vec4& uvRect, SpriteAlphaMode alphaMode) {
+    std::string normalizedPath = NormalizePath(path);
+    auto it = slotIndices.find(normalizedPath);
+    if (it != slotIndices.end()) {
+        TextureSlot& slot = textureSlots[it->second];
+        slot.refs++;
+        return { it->second, slot.generation };
+    }
+
+    TextureSlot slot;
+    slot.texture = texture;
+    slot.uvRect = uvRect;
+    slot.alphaMode = alphaMode;
+    slot.region = true;
+    return AllocateSlot(normalizedPath, slot);
+}
+
+void TextureManager::InvalidateHandles() {
+    for (auto& [path, index] : slotIndices) {
+        // Generation 0 dilewati, handle dengan generation 0 selalu berarti belum di-resolve
+        TextureSlot& slot = textureSlots[index];
+        if (++slot.generation == 0) slot.generation = 1;
+        slot.refs = 0;
+        freeSlots.push_back(index);
+    }
+    slotIndices.clear();
+}
+
 void TextureManager::ClearTextures() {
+    // Decode yang masih berjalan selesai dengan generation lama dan dibuang saat upload
+    {
+        lock_guard<std::mutex> lock(streamMutex);
+        decodeQueue.clear();
+        decodedImages.clear();
+    }
+    streamGeneration++;
+    uploadQueue.clear();
+    pendingPaths.clear();
+    failedPaths.clear();
+
     for (const auto& [path, textureID] : textureCache) {
-        if (textureID > 0) {
-            glDeleteTextures(1, &textureID);
+        if (textureID > 0 && textureID != placeholderTexture) {
+            ImageCache::Shared().Release(path, ImageVariant::FULL);
         }
     }
     textureCache.clear();
-}
\ No newline at end of file
+    alphaModes.clear();
+    residency.clear();
+    evictedPaths.clear();
+    streamStats.residentTextures = 0;
+    streamStats.residentBytes = 0;
+    InvalidateHandles();
+}
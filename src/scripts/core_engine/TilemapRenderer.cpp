@@ -0,0 +1,202 @@
+#include <TilemapRenderer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <Debugger.hpp>
+
+using namespace std;
+
+TilemapRenderer::~TilemapRenderer() {
+    Shutdown();
+}
+
+void TilemapRenderer::Init(GLStateCache& stateCache) {
+    state = &stateCache;
+    scratch.reserve(ChunkTiles * 4);
+
+    // Satu chunk paling banyak ChunkTiles * 4 vertex, index 16-bit cukup
+    vector<GLushort> indices(ChunkTiles * 6);
+    for (GLushort i = 0, v = 0; i < ChunkTiles * 6; i += 6, v += 4) {
+        indices[i + 0] = v + 0;
+        indices[i + 1] = v + 1;
+        indices[i + 2] = v + 2;
+        indices[i + 3] = v + 0;
+        indices[i + 4] = v + 2;
+        indices[i + 5] = v + 3;
+    }
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &ebo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+    // Pointer atribut diatur per chunk ke vertex buffer chunk itu
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+}
+
+void TilemapRenderer::Shutdown() {
+    Clear();
+    if (ebo) { glDeleteBuffers(1, &ebo); ebo = 0; }
+    if (vao) {
+        if (state) state->ForgetVertexArray(vao);
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+}
+
+void TilemapRenderer::Clear() {
+    for (MapCache& cache : caches) {
+        for (Chunk& chunk : cache.chunks) ReleaseChunk(chunk);
+    }
+    caches.clear();
+}
+
+void TilemapRenderer::ReleaseChunk(Chunk& chunk) {
+    if (chunk.vbo) {
+        glDeleteBuffers(1, &chunk.vbo);
+        stats.residentChunks--;
+        stats.gpuBytes -= uint64_t(chunk.tileCount) * 4 * sizeof(SpriteVertex);
+    }
+    chunk = Chunk();
+}
+
+bool TilemapRenderer::LayoutChanged(const MapCache& cache, const Tilemap& map) const {
+    return cache.id != map.id || cache.x != map.x || cache.y != map.y || cache.tileSize != map.tileSize ||
+           cache.width != map.GetWidth() || cache.height != map.GetHeight() ||
+           cache.columns != map.tilesetColumns || cache.rows != map.tilesetRows;
+}
+
+void TilemapRenderer::ResetCache(MapCache& cache, const Tilemap& map) {
+    for (Chunk& chunk : cache.chunks) ReleaseChunk(chunk);
+    cache.id = map.id;
+    cache.x = map.x;
+    cache.y = map.y;
+    cache.tileSize = map.tileSize;
+    cache.width = map.GetWidth();
+    cache.height = map.GetHeight();
+    cache.columns = map.tilesetColumns;
+    cache.rows = map.tilesetRows;
+    cache.chunks.assign(size_t(map.GetChunksX()) * map.GetChunksY(), Chunk());
+}
+
+void TilemapRenderer::BuildChunk(const Tilemap& map, int cx, int cy, Chunk& chunk) {
+    scratch.clear();
+    int columns = max(map.tilesetColumns, 1);
+    int rows = max(map.tilesetRows, 1);
+    int endX = min((cx + 1) * Tilemap::ChunkSize, map.GetWidth());
+    int endY = min((cy + 1) * Tilemap::ChunkSize, map.GetHeight());
+
+    for (int ty = cy * Tilemap::ChunkSize; ty < endY; ty++) {
+        for (int tx = cx * Tilemap::ChunkSize; tx < endX; tx++) {
+            uint16_t tile = map.GetTile(tx, ty);
+            if (tile == 0 || tile > columns * rows) continue;
+
+            // Tile tileset dihitung dari kiri atas, texture di-load terbalik jadi v = 1 di atas
+            int column = (tile - 1) % columns;
+            int row = (tile - 1) / columns;
+            float u0 = float(column) / columns, u1 = float(column + 1) / columns;
+            float v0 = 1.0f - float(row + 1) / rows, v1 = 1.0f - float(row) / rows;
+
+            float x0 = map.x + tx * map.tileSize, x1 = x0 + map.tileSize;
+            float y0 = map.y + ty * map.tileSize, y1 = y0 + map.tileSize;
+            scratch.push_back({ x0, y0, 0.0f, u0, v0 });
+            scratch.push_back({ x1, y0, 0.0f, u1, v0 });
+            scratch.push_back({ x1, y1, 0.0f, u1, v1 });
+            scratch.push_back({ x0, y1, 0.0f, u0, v1 });
+        }
+    }
+
+    uint32_t tileCount = static_cast<uint32_t>(scratch.size() / 4);
+    if (chunk.vbo) stats.gpuBytes -= uint64_t(chunk.tileCount) * 4 * sizeof(SpriteVertex);
+    if (tileCount == 0) {
+        // Chunk kosong tidak perlu buffer
+        if (chunk.vbo) {
+            glDeleteBuffers(1, &chunk.vbo);
+            chunk.vbo = 0;
+            stats.residentChunks--;
+        }
+    } else {
+        if (!chunk.vbo) {
+            glGenBuffers(1, &chunk.vbo);
+            stats.residentChunks++;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        glBufferData(GL_ARRAY_BUFFER, scratch.size() * sizeof(SpriteVertex), scratch.data(), GL_STATIC_DRAW);
+        stats.gpuBytes += uint64_t(tileCount) * 4 * sizeof(SpriteVertex);
+    }
+    chunk.tileCount = tileCount;
+    chunk.revision = map.GetChunkRevision(cx, cy);
+    stats.chunksBuilt++;
+}
+
+void TilemapRenderer::Render(const Scene& scene, TextureManager& textures, ShaderProgram& program,
+                             float minX, float minY, float maxX, float maxY) {
+    frame++;
+    stats.visibleChunks = stats.chunksBuilt = stats.drawCalls = stats.tilesDrawn = 0;
+
+    // Tilemap yang dihapus dari scene melepas semua chunk-nya
+    while (caches.size() > scene.tilemaps.size()) {
+        for (Chunk& chunk : caches.back().chunks) ReleaseChunk(chunk);
+        caches.pop_back();
+    }
+    caches.resize(scene.tilemaps.size());
+    if (scene.tilemaps.empty()) return;
+
+    drawOrder.resize(scene.tilemaps.size());
+    for (uint32_t i = 0; i < drawOrder.size(); i++) drawOrder[i] = i;
+    stable_sort(drawOrder.begin(), drawOrder.end(), [&](uint32_t a, uint32_t b) {
+        const Tilemap& mapA = scene.tilemaps[a];
+        const Tilemap& mapB = scene.tilemaps[b];
+        if (mapA.layer != mapB.layer) return mapA.layer < mapB.layer;
+        return mapA.depth < mapB.depth;
+    });
+
+    program.Use(*state);
+    program.SetInt("u_Texture", 0);
+    program.SetFloat("u_AlphaCutoff", 0.1f);
+    state->BindVertexArray(vao);
+
+    for (uint32_t index : drawOrder) {
+        const Tilemap& map = scene.tilemaps[index];
+        MapCache& cache = caches[index];
+        if (LayoutChanged(cache, map)) ResetCache(cache, map);
+        if (map.GetWidth() == 0 || map.GetHeight() == 0 || map.tileSize <= 0.0f || map.tilesetPath.empty()) continue;
+
+        GLuint texture = textures.RequestTexture(map.tilesetPath);
+        if (texture == 0) continue;
+
+        // Rentang chunk yang bersinggungan dengan rect kamera
+        float chunkWorld = map.tileSize * Tilemap::ChunkSize;
+        int cx0 = max(0, (int)floor((minX - map.x) / chunkWorld));
+        int cy0 = max(0, (int)floor((minY - map.y) / chunkWorld));
+        int cx1 = min(map.GetChunksX() - 1, (int)floor((maxX - map.x) / chunkWorld));
+        int cy1 = min(map.GetChunksY() - 1, (int)floor((maxY - map.y) / chunkWorld));
+
+        for (int cy = cy0; cy <= cy1; cy++) {
+            for (int cx = cx0; cx <= cx1; cx++) {
+                Chunk& chunk = cache.chunks[size_t(cy) * map.GetChunksX() + cx];
+                chunk.lastUsed = frame;
+                stats.visibleChunks++;
+                if (chunk.revision != map.GetChunkRevision(cx, cy)) BuildChunk(map, cx, cy, chunk);
+                if (chunk.tileCount == 0) continue;
+
+                state->BindTexture(0, texture);
+                glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+                glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, x));
+                glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, u));
+                glDrawElements(GL_TRIANGLES, chunk.tileCount * 6, GL_UNSIGNED_SHORT, 0);
+                stats.drawCalls++;
+                stats.tilesDrawn += chunk.tileCount;
+            }
+        }
+    }
+
+    // Chunk yang lama tidak terlihat dilepas, akan di-bake ulang kalau terlihat lagi
+    for (MapCache& cache : caches) {
+        for (Chunk& chunk : cache.chunks) {
+            if (chunk.vbo && frame - chunk.lastUsed > MaxIdleFrames) ReleaseChunk(chunk);
+        }
+    }
+}
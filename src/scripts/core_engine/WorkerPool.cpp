@@ -0,0 +1,109 @@
+#include <WorkerPool.hpp>
+#include <algorithm>
+#include <Debugger.hpp>
+
+using namespace std;
+
+WorkerPool& WorkerPool::Shared() {
+    static WorkerPool pool(max(1u, thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+WorkerPool::WorkerPool(unsigned workerCount) {
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+    Debug::Logger::Log("[WorkerPool] Started " + to_string(workerCount) + " worker threads", Debug::LogLevel::INFO);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+size_t WorkerPool::ChunkSize(size_t count, size_t minChunkSize, size_t alignment) const {
+    alignment = max<size_t>(alignment, 1);
+    // Beberapa chunk per thread supaya thread yang cepat bisa mengambil sisa pekerjaan
+    size_t target = (count + GetThreadCount() * 4 - 1) / (GetThreadCount() * 4);
+    size_t size = max(max<size_t>(minChunkSize, 1), target);
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+size_t WorkerPool::ChunkCount(size_t count, size_t minChunkSize, size_t alignment) const {
+    if (count == 0) return 0;
+    size_t size = ChunkSize(count, minChunkSize, alignment);
+    return (count + size - 1) / size;
+}
+
+void WorkerPool::ParallelFor(size_t count, size_t minChunkSize, const function<void(size_t, size_t, size_t)>& job, size_t alignment) {
+    size_t chunkSize = ChunkSize(count, minChunkSize, alignment);
+    size_t chunks = ChunkCount(count, minChunkSize, alignment);
+    if (chunks == 0) return;
+
+    if (chunks == 1 || workers.empty()) {
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            job(chunk, chunk * chunkSize, min(count, (chunk + 1) * chunkSize));
+        }
+        return;
+    }
+
+    lock_guard<std::mutex> submitLock(submitMutex);
+    {
+        // Worker yang terlambat bangun untuk job sebelumnya harus keluar dulu sebelum field job diganti
+        unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return activeWorkers == 0; });
+        currentJob = &job;
+        jobCount = count;
+        jobChunkSize = chunkSize;
+        jobChunks = chunks;
+        nextChunk = 0;
+        finishedChunks = 0;
+        generation++;
+    }
+    wake.notify_all();
+
+    RunChunks();
+
+    // Tunggu chunk yang masih dikerjakan worker dan worker keluar dari job ini
+    unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return finishedChunks.load() == jobChunks && activeWorkers == 0; });
+    currentJob = nullptr;
+}
+
+void WorkerPool::RunChunks() {
+    for (;;) {
+        size_t chunk = nextChunk.fetch_add(1);
+        if (chunk >= jobChunks) break;
+        size_t begin = chunk * jobChunkSize;
+        (*currentJob)(chunk, begin, min(jobCount, begin + jobChunkSize));
+        finishedChunks.fetch_add(1);
+    }
+}
+
+void WorkerPool::WorkerLoop() {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            activeWorkers++;
+        }
+
+        RunChunks();
+
+        {
+            lock_guard<std::mutex> lock(mutex);
+            activeWorkers--;
+        }
+        done.notify_all();
+    }
+}
@@ -3,6 +3,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <Debugger.hpp>
+#include <stb_image_write.h>
+#include <ctime>
 
 void MainWindow::RenderHierarchyWindow() {  
     ImGui::Begin("Hierarchy", nullptr, ImGuiWindowFlags_NoCollapse);
@@ -356,6 +358,11 @@ void MainWindow::RenderSceneToolbarView(ImVec2 parentPos, ImVec2 parentSize) {
         
         ImGui::SameLine();
         ImGui::Text("Zoom");
+
+        ImGui::SameLine(0, 15);
+        if (ImGui::Button("Screenshot")) {
+            SaveSceneScreenshot();
+        }
         
         // New line for more controls
         ImGui::NewLine();
@@ -409,12 +416,87 @@ void MainWindow::RenderSceneToolbarView(ImVec2 parentPos, ImVec2 parentSize) {
         const char* viewModes[] = {"2D", "3D", "Wireframe"};
         ImGui::SetNextItemWidth(80);
         ImGui::Combo("##ViewMode", &viewMode, viewModes, IM_ARRAYSIZE(viewModes));
+
+        // Sprite path selector, untuk benchmark batched vs instanced
+        ImGui::NewLine();
+        int spritePath = (int)sceneRenderer2D->GetSpriteRenderPath();
+        const char* spritePaths[] = {"Batched", "Instanced"};
+        ImGui::SetNextItemWidth(100);
+        if (ImGui::Combo("##SpritePath", &spritePath, spritePaths, IM_ARRAYSIZE(spritePaths))) {
+            sceneRenderer2D->SetSpriteRenderPath((SceneRenderer2D::SpriteRenderPath)spritePath);
+        }
+        
+        ImGui::SameLine();
+        ImGui::Text("Sprite Path");
+
+        ImGui::SameLine(0, 15);
+        ImGui::Checkbox("Render Stats", &showRenderStats);
+
+        ImGui::SameLine(0, 15);
+        bool showBounds = sceneRenderer2D->GetShowBounds();
+        if (ImGui::Checkbox("Bounds", &showBounds)) {
+            sceneRenderer2D->SetShowBounds(showBounds);
+        }
+
+        ImGui::SameLine();
+        bool picking = sceneRenderer2D->GetPickingEnabled();
+        if (ImGui::Checkbox("GPU Pick", &picking)) {
+            sceneRenderer2D->SetPickingEnabled(picking);
+        }
+
+        ImGui::SameLine(0, 15);
+        bool showOverdraw = sceneRenderer2D->GetShowOverdraw();
+        if (ImGui::Checkbox("Overdraw", &showOverdraw)) {
+            sceneRenderer2D->SetShowOverdraw(showOverdraw);
+        }
+
+        ImGui::SameLine();
+        bool earlyDepth = sceneRenderer2D->GetEarlyDepth();
+        if (ImGui::Checkbox("Early-Z", &earlyDepth)) {
+            sceneRenderer2D->SetEarlyDepth(earlyDepth);
+        }
+        const SpriteOverdrawStats& overdraw = sceneRenderer2D->GetOverdrawStats();
+        if (showOverdraw && overdraw.overdraw >= 0.0f) {
+            ImGui::SameLine();
+            ImGui::Text("%.2fx", overdraw.overdraw);
+        }
     }
     ImGui::End();
 
     ImGui::PopStyleVar(1);
 }
 
+void MainWindow::SaveSceneScreenshot() {
+    std::string sceneName = projectHandler.currentScenePath.empty()
+        ? std::string("scene") : fs::path(projectHandler.currentScenePath).stem().string();
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    std::string path = "screenshots/" + sceneName + "_" + timestamp + ".png";
+
+    sceneRenderer2D->RequestViewportCapture(0, 0, [this, path](const ReadbackImage& image) {
+        std::error_code ec;
+        fs::create_directories(fs::path(path).parent_path(), ec);
+        if (stbi_write_png(path.c_str(), image.width, image.height, 4, image.pixels.data(), image.width * 4)) {
+            Debug::Logger::Log("Screenshot saved to " + path, Debug::LogLevel::SUCCESS);
+        } else {
+            Debug::Logger::Log("Failed to write screenshot " + path, Debug::LogLevel::WARNING);
+        }
+    });
+}
+
+void MainWindow::CaptureSceneThumbnail(const std::string& scenePath) {
+    std::string path = projectHandler.GetSceneThumbnailPath(scenePath);
+    // Diperkecil di GPU ke ukuran icon asset browser, hanya beberapa KB yang dibaca
+    sceneRenderer2D->RequestViewportCapture(128, 128, [this, path](const ReadbackImage& image) {
+        std::error_code ec;
+        fs::create_directories(fs::path(path).parent_path(), ec);
+        if (stbi_write_png(path.c_str(), image.width, image.height, 4, image.pixels.data(), image.width * 4)) {
+            projectHandler.RefreshCachedIcon(path, image.width, image.height, image.pixels.data());
+        }
+    });
+}
+
 void MainWindow::RenderSceneWindow() {
     if (!showScene) return;
 
@@ -440,8 +522,31 @@ void MainWindow::RenderSceneWindow() {
         ImVec2 windowSize = ImGui::GetWindowSize();
         ImVec2 contentSize = ImGui::GetContentRegionAvail();
 
-        // Render scene dengan ukuran penuh
+        // Render scene dengan ukuran penuh, partikel disimulasikan dulu dengan dt frame ImGui
+        sceneRenderer2D->SetEditScene(&projectHandler.currentScene);
+        sceneRenderer2D->UpdateParticles(projectHandler.currentScene, ImGui::GetIO().DeltaTime);
         sceneRenderer2D->RenderSceneToTexture(projectHandler.currentScene);
+        sceneRenderer2D->DrawViewportImage();
+
+        // Thumbnail asset browser diambil sekali setiap scene dibuka
+        static std::string thumbnailScenePath;
+        if (!projectHandler.currentScenePath.empty() && thumbnailScenePath != projectHandler.currentScenePath) {
+            thumbnailScenePath = projectHandler.currentScenePath;
+            CaptureSceneThumbnail(thumbnailScenePath);
+        }
+
+        // Overlay statistik per pass di pojok kiri atas viewport
+        if (showRenderStats) {
+            ImGui::SetCursorPos(ImVec2(10, 40));
+            ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.0f, 0.0f, 0.0f, 0.6f));
+            ImGui::BeginChild("RenderStats", ImVec2(460, 150), true);
+            sceneRenderer2D->DrawStatsOverlay();
+            if (ImGui::Button("Dump JSON")) {
+                sceneRenderer2D->DumpRenderStats("render_stats.json");
+            }
+            ImGui::EndChild();
+            ImGui::PopStyleColor();
+        }
         
         // Dapatkan texture ID dari scene renderer
         // ImTextureID sceneTexture = (ImTextureID)(intptr_t)sceneRenderer2D->GetSceneTextureID();
@@ -456,8 +561,22 @@ void MainWindow::RenderSceneWindow() {
         ImGui::SetCursorPos(ImVec2(0, windowSize.y - 25));
         // ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.0f, 0.0f, 0.0f, 0.5f));
         ImGui::BeginChild("StatusBar", ImVec2(windowSize.x, 25), false);
-        ImGui::Text(" Scene View | FPS: %.1f | Zoom: %.2fx", 
-                    ImGui::GetIO().Framerate, sceneRenderer2D->GetZoom());
+        const SpriteBatchStats& batchStats = sceneRenderer2D->GetSpriteBatchStats();
+        const GLStateStats& stateStats = sceneRenderer2D->GetStateStats();
+        const SpriteCullStats& cullStats = sceneRenderer2D->GetCullStats();
+        ImGui::Text(" Scene View%s | FPS: %.1f | Zoom: %.2fx | Visible: %u/%u (culled %u, %.3f ms) | Draw Calls: %u (saved %u) | GL State: %u (dropped %u)", 
+                    sceneRenderer2D->WasLastFrameSkipped() ? " (idle)" : "",
+                    ImGui::GetIO().Framerate, sceneRenderer2D->GetZoom(),
+                    cullStats.visible, cullStats.total, cullStats.culled, cullStats.testMs,
+                    batchStats.drawCalls, batchStats.drawCallsSaved,
+                    stateStats.issued, stateStats.dropped);
+        const TextureStreamStats& streamStats = sceneRenderer2D->GetTextureStreamStats();
+        if (streamStats.queued + streamStats.ready > 0) {
+            ImGui::SameLine();
+            ImGui::Text("| Loading textures: %u", streamStats.queued + streamStats.ready);
+        }
+        ImGui::SameLine();
+        ImGui::Text("| Textures: %.1f MB", streamStats.residentBytes / (1024.0 * 1024.0));
         ImGui::EndChild();
         // ImGui::PopStyleColor();
     }
@@ -867,8 +986,8 @@ void MainWindow::HandleBackground(const ImVec2& windowPos, const ImVec2& windowS
         (ImTextureID)(intptr_t)backgroundTexture.TextureID,
         ImVec2(imageX, imageY),
         ImVec2(imageX + imageWidth, imageY + imageHeight),
-        ImVec2(0, 0),
-        ImVec2(1, 1),
+        ImVec2(0, 1),
+        ImVec2(1, 0),
         ImGui::ColorConvertFloat4ToU32(ImVec4(1, 1, 1, volume))
     );
 }
@@ -1,4 +1,5 @@
 #include <Debugger.hpp>
+#include <ImageCache.hpp>
 #include "MainWindow.hpp"
 using namespace Debug;
 
@@ -592,9 +593,9 @@ void HandlerProject::DrawFileExplorer(AssetFile& node)
     ImGui::GetWindowDrawList()->AddImage(
         GetIconForFile(node).textureId,
         ImVec2(iconPosX, iconPosY),
-        ImVec2(iconPosX + thumbnailSize.x, iconPosY + thumbnailSize.y)
-        // ImVec2(0, 1),
-        // ImVec2(1, 0)
+        ImVec2(iconPosX + thumbnailSize.x, iconPosY + thumbnailSize.y),
+        ImVec2(0, 1),
+        ImVec2(1, 0)
     );
 
     // Nama file
@@ -931,69 +932,34 @@ void HandlerProject::DrawIconFromImage(const char* iconPath, int width, int heig
     // ImTextureID texID = assets.LoadTextureFromFile(iconPath, &icon_texture_data); // bikin sendiri atau cache
     ImTextureID texID = GetCachedIcon(iconPath);
     if (texID) {
-        ImGui::Image(texID, ImVec2(width, height));
+        ImGui::Image(texID, ImVec2(width, height), ImVec2(0, 1), ImVec2(1, 0));
         ImGui::SameLine();
     }
 }
 
 HandlerProject::IconInfo HandlerProject::LoadCachedTexture(const std::string& path) {
-    // Sudah ada di cache? Return langsung
-    auto it = iconCacheInfo.find(path);
-    if (it != iconCacheInfo.end()) return it->second;
-
-    // Load dari file
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(true); // Wajib sebelum stbi_load
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
-    if (!data) {
+    // Thumbnail dari ImageCache, gambar yang juga dipakai scene tidak di-decode dua kali
+    ImageView view = ImageCache::Shared().Get(path, ImageVariant::THUMBNAIL);
+    if (view.texture == 0) {
         std::cerr << "Failed to load icon: " << path << std::endl;
         return { (ImTextureID)0, 0, 0 };
     }
 
-    // Buat OpenGL texture (atau sesuai renderer kamu)
-    GLuint textureId;
-    glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); // filter bisa disesuaikan
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    FlipImageVertically(data, width, height, channels);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    
-    stbi_image_free(data);
-
     IconInfo info;
-    info.textureId = (ImTextureID)(intptr_t)textureId;
-    info.width = width;
-    info.height = height;
-
-    iconCacheInfo[path] = info;
+    info.textureId = (ImTextureID)(intptr_t)view.texture;
+    info.width = view.width;
+    info.height = view.height;
     return info;
 }
 
-ImTextureID HandlerProject::GetCachedIcon(const std::string& path) {
-    auto it = iconCache.find(path);
-    if (it != iconCache.end())
-        return it->second;
-
-    int w, h, channels;
-    // stbi_set_flip_vertically_on_load(true); // Wajib sebelum stbi_load
-    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 4);
-    if (!data) return (ImTextureID)0;
-
-    GLuint tex;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    stbi_image_free(data);
+void HandlerProject::RefreshCachedIcon(const std::string& path, int width, int height, const unsigned char* pixels) {
+    // Belum pernah ditampilkan: load biasa dari disk nanti. Nama texture tetap sama, draw list ImGui frame ini masih valid
+    ImageCache::Shared().Replace(path, width, height, pixels);
+    sceneThumbnailExists[path] = true;
+}
 
-    iconCache[path] = (ImTextureID)(intptr_t)tex;
-    return iconCache[path];
+ImTextureID HandlerProject::GetCachedIcon(const std::string& path) {
+    return LoadCachedTexture(path).textureId;
 }
 
 void HandlerProject::StartFileWatcher() {
@@ -1497,6 +1463,12 @@ void HandlerProject::HandleImport(const std::string& targetFolder) {
         // Copy file
         fs::copy(sourcePath, targetPath, fs::copy_options::overwrite_existing);
 
+        // Texture langsung di-cook (Decode menulis .ilmeetex), load pertama di scene tidak perlu decode PNG lagi
+        if (TextureCooker::IsCookable(targetPath.string())) {
+            DecodedImage cooked;
+            ImageCache::Shared().Decode(targetPath.string(), cooked);
+        }
+
         ShowNotification("Import Successful", 
             "Imported: " + sourcePath.filename().string() + "\nTo: " + targetFolder, 
             ImVec4(0.3f, 1.0f, 0.3f, 1.0f));
@@ -1695,7 +1667,8 @@ HandlerProject::IconInfo HandlerProject::GenerateVideoThumbnail(const std::strin
     GLuint textureID;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
-    // FlipImageVertically(bestFrameData.data(), thumbnailSize.x, thumbnailSize.y, 4);
+    // Baris bawah dulu seperti texture ImageCache, icon digambar dengan UV terbalik
+    FlipImageVertically(rgbFrame->data[0], thumbnailSize.x, thumbnailSize.y, 3);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, thumbnailSize.x, thumbnailSize.y, 
                 0, GL_RGB, GL_UNSIGNED_BYTE, rgbFrame->data[0]);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -139,16 +139,10 @@ bool MainWindow::init(const char* title) {
     Debug::Logger::Log("Main Window Successfully Initialized");
     
     sceneRenderer2D = new SceneRenderer2D(800, 600);
+    // Selection dan hover lewat attachment ID viewport
+    sceneRenderer2D->SetPickingEnabled(true);
     networkManager = std::make_unique<NetworkManager>();
     networkManager->connectToServer();
-    // glGenFramebuffers(1, &blurFBO);
-    // glGenTextures(1, &blurTexture);
-    // glBindTexture(GL_TEXTURE_2D, blurTexture);
-    // glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, blurWidth, blurHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    // glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    // glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    // glBindFramebuffer(GL_FRAMEBUFFER, blurFBO);
-    // glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, blurTexture, 0);
     // viewPort.Init();
     return true;
 }
@@ -1594,6 +1588,7 @@ void MainWindow::render() {
     // ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     SDL_GL_SwapWindow(window);
+    RenderTargetPool::Shared().EndFrame();
 
     // set_mainbackground();
 
@@ -1607,6 +1602,8 @@ void MainWindow::clean() {
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     glDeleteTextures(1, &videoPlayer->glTextureID);
+    RenderTargetPool::Shared().Shutdown();
+    ImageCache::Shared().Shutdown();
     ImGui::DestroyContext();
 
     if (glContext)
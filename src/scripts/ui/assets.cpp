@@ -3,46 +3,31 @@
 // Untuk memuat gambar
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include <ImageCache.hpp>
 // Fungsi untuk memuat tekstur dari file gambar
 bool Assets::LoadTextureFromFile(const char* filename, TextureData* out_texture)
 {
-    // Flip image vertically during loading
-    // stbi_set_flip_vertically_on_load(true);
-
-    // Load image from file
-    int width, height, channels;
-    unsigned char* data = stbi_load(filename, &width, &height, &channels, 4);
-    if (data == NULL) {
+    // Lewat cache bersama: background yang pernah dipakai tidak di-decode ulang saat diganti lagi.
+    // Texture baris bawah dulu, gambar dengan UV (0,1)-(1,0).
+    ImageView view = ImageCache::Shared().Get(filename, ImageVariant::FULL);
+    if (view.texture == 0) {
         std::cerr << "Failed to load texture: " << filename << std::endl;
         return false;
     }
 
-    // Create OpenGL texture
-    GLuint texture_id;
-    glGenTextures(1, &texture_id);
-    glBindTexture(GL_TEXTURE_2D, texture_id);
-    
-    // Setup texture parameters
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    // Upload image data to GPU
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    // Store texture info
+    *out_texture = {(ImTextureID)(intptr_t)view.texture, view.width, view.height};
 
-    // Store texture info and free image memory
-    *out_texture = {texture_id, width, height};
-    GetDominantColor(data, width, height, channels);
-    stbi_image_free(data);
-    
-    // Reset flip setting to default
-    stbi_set_flip_vertically_on_load(false);
+    // Warna dominan dari preview mip kecil yang di-decode ImageCache di CPU, tanpa readback GPU
+    if (const ImagePreview* preview = ImageCache::Shared().FindPreview(filename)) {
+        GetDominantColor(preview->pixels.data(), preview->width, preview->height, 4);
+    }
     return true;
 }
 
-Color Assets::GetDominantColor(unsigned char* data, int width, int height, int channels) {
-    const int borderSize = 50; // Sample from edges, adjust as needed
+Color Assets::GetDominantColor(const unsigned char* data, int width, int height, int channels) {
+    // Sample from edges, sekitar 50 px pada background 1080p, sebanding untuk preview kecil
+    const int borderSize = std::max(1, std::min(width, height) / 20);
     std::vector<std::vector<float>> colorClusters;
     
     // Sample pixels from the borders of the image